@@ -83,6 +83,9 @@ private:
 
   // Private methods.
 
+  /// @brief Function which is passed to thread: waits while thread is assigned and calls _do_in_background().
+  void _run();
+
   // Private copy constructor without implementation to prohibit using it.
   Async_task(const Async_task&);
 
@@ -105,6 +108,9 @@ private:
   // Underlying thread used to execute this task.
   std::thread m_thread;
 
+  // Mutex which is locked while underlying thread is created.
+  std::mutex m_thread_mutex;
+
   // Exception occurred on task execution.
   std::shared_ptr<std::exception> m_error;
 };
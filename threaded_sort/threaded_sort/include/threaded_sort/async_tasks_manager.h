@@ -53,7 +53,8 @@ public:
   /// @brief Checks if all tasks are completed.
   bool are_all_tasks_completed();
 
-  /// @brief Waits for all tasks completion.
+  /// @brief Waits for all tasks completion and joins their threads.
+  /// @exception system_error
   void wait_for_all_tasks_completion();
 
 private:
@@ -66,11 +67,14 @@ private:
   // Private assignment operator without implementation to prohibit using it.
   Async_tasks_manager& operator=(const Async_tasks_manager&);
 
-  /// @brief Joins threads of completed tasks (which can be joined) and removes them.
+  /// @brief Joins threads of tasks (which can be joined) and removes tasks from list.
+  ///        Should be called when m_common_mutex is unlocked.
+  /// @param tasks List of completed tasks.
   /// @exception system_error
-  void _join_and_remove_completed_tasks_which_can_be_joined();
+  static void _join_tasks(std::list<std::shared_ptr<Async_task>>& tasks);
 
   /// @brief Checks all tasks completion condition and signals if it is true.
+  ///        Should be called when m_common_mutex is unlocked.
   void _check_completion_condition();  
 
   // Private fields.
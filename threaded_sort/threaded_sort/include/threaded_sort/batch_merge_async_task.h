@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file batch_merge_async_task.h
+/// @brief Interface and implementation of the Batch_merge_piece struct and the Batch_merge_async_task<T> class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BATCH_MERGE_ASYNC_TASK_H_401BA897_8636_42C2_B014_9877E5C23C29
+#define BATCH_MERGE_ASYNC_TASK_H_401BA897_8636_42C2_B014_9877E5C23C29
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct Batch_merge_piece: piece of merge of sorted batch into sorted vector.
+///
+/// Piece merges elements [first, last) of vector (old positions) with elements [batch_first, batch_last) of batch
+/// into positions [first + batch_first, last + batch_last) of vector.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Batch_merge_piece
+{
+  // Index of the first element of vector.
+  int32_t first;
+
+  // Index of element which follows the last element of vector.
+  int32_t last;
+
+  // Index of the first element of batch.
+  int32_t batch_first;
+
+  // Index of element which follows the last element of batch.
+  int32_t batch_last;
+
+  // Index of the first saved element of piece.
+  int32_t saved_first;
+
+  // Count of saved elements: the first elements of piece which are overwritten by previous pieces.
+  int32_t saved_count;
+}; // struct Batch_merge_piece
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Batch_merge_async_task<T>: asynchronous task which merges piece of sorted batch into sorted vector
+///        in place (vector is already resized to hold batch).
+///
+/// Every piece is merged backward: elements of vector move only to the right, so piece overwrites only its own
+/// elements which are already merged and the first elements of next pieces. The latter are saved before tasks are
+/// started (at most batch_first elements per piece), so pieces are independent. Equal elements of vector precede
+/// elements of batch. Elements should be nothrow move constructible and assignable.
+/// @param <T> Type of elements in vector.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class Batch_merge_async_task final : public Async_task
+{
+public:
+
+  /// @brief Constructor.
+  /// @param vector Reference to vector into which batch is merged.
+  /// @param batch Sorted batch (elements are moved).
+  /// @param piece Piece of merge.
+  /// @param saved_elements Saved elements of all pieces.
+  /// @param tasks_manager Asynchronous tasks manager.
+  Batch_merge_async_task(std::vector<T>& vector, std::vector<T>& batch, const Batch_merge_piece& piece,
+    T* saved_elements, std::shared_ptr<Async_tasks_manager> tasks_manager);
+
+  /// @brief Destructor.
+  virtual ~Batch_merge_async_task();
+
+  /// @brief Merges piece in calling thread (used if task can't be started).
+  /// @exception exception Exception thrown by comparison of elements.
+  void merge();
+
+  /// @brief Checks if merge of piece is started by task (task which failed to start can be merged by caller).
+  bool is_merge_started() const;
+
+  /// @brief Merges piece in calling thread.
+  /// @param vector Reference to vector into which batch is merged.
+  /// @param batch Sorted batch (elements are moved).
+  /// @param piece Piece of merge.
+  /// @param saved_elements Saved elements of all pieces.
+  /// @exception exception Exception thrown by comparison of elements.
+  static void merge(std::vector<T>& vector, std::vector<T>& batch, const Batch_merge_piece& piece,
+    T* saved_elements);
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Batch_merge_async_task(const Batch_merge_async_task&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Batch_merge_async_task& operator=(const Batch_merge_async_task&);
+
+  /// @brief Function which is executed in separate thread.
+  ///        Should not throw exceptions.
+  virtual void _do_in_background() override;
+
+  /// @brief Function called when error occurred.
+  /// @param error Exception occurred on execution.
+  virtual void _on_error(const std::shared_ptr<std::exception>& error) override;
+
+  // Private fields.
+
+  // Reference to vector into which batch is merged.
+  std::vector<T>& m_vector;
+
+  // Sorted batch.
+  std::vector<T>& m_batch;
+
+  // Piece of merge.
+  const Batch_merge_piece m_piece;
+
+  // Saved elements of all pieces.
+  T* const m_saved_elements;
+
+  // Flag: merge of piece is started by task.
+  std::atomic<bool> m_is_merge_started;
+
+  // Asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> m_tasks_manager;
+}; // class Batch_merge_async_task
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implementation of the Batch_merge_async_task<T> methods.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+Batch_merge_async_task<T>::Batch_merge_async_task(std::vector<T>& vector, std::vector<T>& batch,
+  const Batch_merge_piece& piece, T* saved_elements, std::shared_ptr<Async_tasks_manager> tasks_manager) :
+    m_vector(vector),
+    m_batch(batch),
+    m_piece(piece),
+    m_saved_elements(saved_elements),
+    m_is_merge_started(false),
+    m_tasks_manager(tasks_manager)
+{
+  assert(piece.first <= piece.last && piece.batch_first <= piece.batch_last);
+  assert(tasks_manager != nullptr);
+}
+
+template<class T>
+Batch_merge_async_task<T>::~Batch_merge_async_task()
+{
+}
+
+template<class T>
+void Batch_merge_async_task<T>::merge()
+{
+  merge(m_vector, m_batch, m_piece, m_saved_elements); // exception
+}
+
+template<class T>
+bool Batch_merge_async_task<T>::is_merge_started() const
+{
+  return m_is_merge_started;
+}
+
+template<class T>
+void Batch_merge_async_task<T>::merge(std::vector<T>& vector, std::vector<T>& batch, const Batch_merge_piece& piece,
+  T* saved_elements)
+{
+  static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+    "Elements should be nothrow movable.");
+
+  assert(piece.first >= 0 && piece.first <= piece.last);
+  assert(piece.batch_first >= 0 && piece.batch_first <= piece.batch_last);
+  assert(piece.last + piece.batch_last <= static_cast<int32_t>(vector.size()));
+  assert(piece.saved_count >= 0 && piece.saved_count <= piece.last - piece.first);
+
+  // The first elements of piece are taken from saved ones.
+  const int32_t unsaved_first = piece.first + piece.saved_count;
+
+  auto get_element = [&](int32_t index) -> T&
+  {
+    return (index < unsaved_first) ? saved_elements[piece.saved_first + index - piece.first] : vector[index];
+  };
+
+  int32_t output = piece.last + piece.batch_last;
+  int32_t i = piece.last;
+  int32_t j = piece.batch_last;
+
+  while (i > piece.first && j > piece.batch_first)
+  {
+    T& element = get_element(i - 1);
+
+    if (batch[j - 1] < element) // exception
+    {
+      vector[--output] = std::move(element);
+
+      i--;
+    }
+    else
+    {
+      vector[--output] = std::move(batch[--j]);
+    }
+  }
+
+  while (j > piece.batch_first)
+  {
+    vector[--output] = std::move(batch[--j]);
+  }
+
+  // Rest of vector elements is shifted by count of batch elements before piece (if any).
+  if (output != i)
+  {
+    while (i > piece.first)
+    {
+      vector[--output] = std::move(get_element(--i));
+    }
+  }
+}
+
+template<class T>
+void Batch_merge_async_task<T>::_do_in_background()
+{
+  bool is_result_ok = true;
+
+  m_is_merge_started = true;
+
+  try
+  {
+    merge(); // exception
+  }
+  catch (std::exception& error)
+  {
+    std::shared_ptr<std::exception> error_ptr = std::make_shared<std::exception>(error);
+
+    _on_error(error_ptr);
+
+    is_result_ok = false;
+  }
+
+  if (is_result_ok)
+  {
+    m_tasks_manager->handle_task_completion(get_task_id(), nullptr);
+
+    _set_status(Status::completed);
+  }
+}
+
+template<class T>
+void Batch_merge_async_task<T>::_on_error(const std::shared_ptr<std::exception>& error)
+{
+  assert(error != nullptr);
+
+  Async_task::_on_error(error);
+
+  m_tasks_manager->handle_task_completion(get_task_id(), error);
+}
+
+} // My_cpp_libs
+
+#endif // BATCH_MERGE_ASYNC_TASK_H_401BA897_8636_42C2_B014_9877E5C23C29
@@ -0,0 +1,35 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file element_pointer.h
+/// @brief Interface and implementation of the Element_pointer<T> struct.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ELEMENT_POINTER_H_987008B8_FFF5_4E5B_953A_2A0A7A5E2D1B
+#define ELEMENT_POINTER_H_987008B8_FFF5_4E5B_953A_2A0A7A5E2D1B
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct Element_pointer<T>: compact proxy of large element used by indirect sort.
+///        Proxies are compared by pointed elements, so sorting of proxies moves only pointers.
+/// @param <T> Type of pointed element.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+struct Element_pointer
+{
+  // Pointer to element.
+  T* element;
+}; // struct Element_pointer
+
+/// @brief Compares pointed elements.
+template<class T>
+inline bool operator<(const Element_pointer<T>& left, const Element_pointer<T>& right)
+{
+  return (*left.element < *right.element);
+}
+
+} // My_cpp_libs
+
+#endif // ELEMENT_POINTER_H_987008B8_FFF5_4E5B_953A_2A0A7A5E2D1B
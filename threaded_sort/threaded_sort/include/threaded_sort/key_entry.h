@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file key_entry.h
+/// @brief Interface and implementation of the Key_entry<Key> and Key_entry_compare<Key, Compare> structs.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef KEY_ENTRY_H_2C194186_CCC0_4279_8CD9_5016A8D0A0D2
+#define KEY_ENTRY_H_2C194186_CCC0_4279_8CD9_5016A8D0A0D2
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct Key_entry<Key>: cached key of element sorted by Threaded_sort::sort_by_key().
+///        Entries are compared by keys and then by indices of elements, so order of sorted entries is unique
+///        (elements with equal keys keep their order).
+/// @param <Key> Type of key.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Key>
+struct Key_entry
+{
+  // Key of element.
+  Key key;
+
+  // Index of element in sorted vector.
+  int32_t index;
+}; // struct Key_entry
+
+/// @brief Compares keys, equal keys are ordered by indices.
+template<class Key>
+inline bool operator<(const Key_entry<Key>& left, const Key_entry<Key>& right)
+{
+  if (left.key < right.key)
+  {
+    return true;
+  }
+
+  return (!(right.key < left.key) && left.index < right.index);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct Key_entry_compare<Key, Compare>: compares key entries by keys with given comparison, equal keys
+///        are ordered by indices (as operator< of Key_entry<Key>).
+/// @param <Key> Type of key.
+/// @param <Compare> Function bool(const Key& left, const Key& right) which checks if left key precedes right one.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Key, class Compare>
+struct Key_entry_compare
+{
+  // Public methods.
+
+  /// @brief Compares keys, equal keys are ordered by indices.
+  bool operator()(const Key_entry<Key>& left, const Key_entry<Key>& right) const
+  {
+    if (compare(left.key, right.key))
+    {
+      return true;
+    }
+
+    return (!compare(right.key, left.key) && left.index < right.index);
+  }
+
+  // Public fields.
+
+  // Comparison of keys.
+  Compare compare;
+}; // struct Key_entry_compare
+
+} // My_cpp_libs
+
+#endif // KEY_ENTRY_H_2C194186_CCC0_4279_8CD9_5016A8D0A0D2
@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file key_extract_async_task.h
+/// @brief Interface and implementation of the Key_extract_async_task<T, Key, Projection> class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef KEY_EXTRACT_ASYNC_TASK_H_0B289531_F2EB_4C87_B450_D647E7FA73A4
+#define KEY_EXTRACT_ASYNC_TASK_H_0B289531_F2EB_4C87_B450_D647E7FA73A4
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Key_extract_async_task<T, Key, Projection>: asynchronous task which computes keys of chunk of
+///        elements into key entries (projection is called exactly once for every element).
+/// @param <T> Type of elements in vector.
+/// @param <Key> Type of key.
+/// @param <Projection> Function Key(const T& element) or pointer to member of T (called by std::invoke).
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T, class Key, class Projection>
+class Key_extract_async_task final : public Async_task
+{
+public:
+
+  /// @brief Constructor.
+  /// @param vector Reference to vector of elements.
+  /// @param entries Key entries (count is size of vector, they may be allocated from workspace).
+  /// @param first Index of the first element of chunk.
+  /// @param last Index of element which follows the last element of chunk.
+  /// @param projection Projection (copied).
+  /// @param tasks_manager Asynchronous tasks manager.
+  Key_extract_async_task(const std::vector<T>& vector, Key_entry<Key>* entries, int32_t first,
+    int32_t last, const Projection& projection, std::shared_ptr<Async_tasks_manager> tasks_manager);
+
+  /// @brief Destructor.
+  virtual ~Key_extract_async_task();
+
+  /// @brief Computes keys of chunk in calling thread.
+  /// @param vector Reference to vector of elements.
+  /// @param entries Key entries (count is size of vector, they may be allocated from workspace).
+  /// @param first Index of the first element of chunk.
+  /// @param last Index of element which follows the last element of chunk.
+  /// @param projection Projection.
+  /// @exception exception Exception thrown by projection or assignment of key.
+  static void extract(const std::vector<T>& vector, Key_entry<Key>* entries, int32_t first,
+    int32_t last, Projection& projection);
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Key_extract_async_task(const Key_extract_async_task&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Key_extract_async_task& operator=(const Key_extract_async_task&);
+
+  /// @brief Function which is executed in separate thread.
+  ///        Should not throw exceptions.
+  virtual void _do_in_background() override;
+
+  /// @brief Function called when error occurred.
+  /// @param error Exception occurred on execution.
+  virtual void _on_error(const std::shared_ptr<std::exception>& error) override;
+
+  // Private fields.
+
+  // Reference to vector of elements.
+  const std::vector<T>& m_vector;
+
+  // Key entries.
+  Key_entry<Key>* const m_entries;
+
+  // Index of the first element of chunk.
+  const int32_t m_first;
+
+  // Index of element which follows the last element of chunk.
+  const int32_t m_last;
+
+  // Projection.
+  Projection m_projection;
+
+  // Asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> m_tasks_manager;
+}; // class Key_extract_async_task
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implementation of the Key_extract_async_task<T, Key, Projection> methods.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class T, class Key, class Projection>
+Key_extract_async_task<T, Key, Projection>::Key_extract_async_task(const std::vector<T>& vector,
+  Key_entry<Key>* entries, int32_t first, int32_t last, const Projection& projection,
+  std::shared_ptr<Async_tasks_manager> tasks_manager) :
+    m_vector(vector),
+    m_entries(entries),
+    m_first(first),
+    m_last(last),
+    m_projection(projection),
+    m_tasks_manager(tasks_manager)
+{
+  assert(first >= 0 && first <= last && last <= static_cast<int32_t>(vector.size()));
+  assert(entries != nullptr);
+  assert(tasks_manager != nullptr);
+}
+
+template<class T, class Key, class Projection>
+Key_extract_async_task<T, Key, Projection>::~Key_extract_async_task()
+{
+}
+
+template<class T, class Key, class Projection>
+void Key_extract_async_task<T, Key, Projection>::extract(const std::vector<T>& vector,
+  Key_entry<Key>* entries, int32_t first, int32_t last, Projection& projection)
+{
+  assert(first >= 0 && first <= last && last <= static_cast<int32_t>(vector.size()));
+  assert(entries != nullptr);
+
+  for (int32_t i = first; i < last; i++)
+  {
+    entries[i].key = std::invoke(projection, vector[i]); // exception
+    entries[i].index = i;
+  }
+}
+
+template<class T, class Key, class Projection>
+void Key_extract_async_task<T, Key, Projection>::_do_in_background()
+{
+  bool is_result_ok = true;
+
+  try
+  {
+    extract(m_vector, m_entries, m_first, m_last, m_projection); // exception
+  }
+  catch (std::exception& error)
+  {
+    std::shared_ptr<std::exception> error_ptr = std::make_shared<std::exception>(error);
+
+    _on_error(error_ptr);
+
+    is_result_ok = false;
+  }
+
+  if (is_result_ok)
+  {
+    m_tasks_manager->handle_task_completion(get_task_id(), nullptr);
+
+    _set_status(Status::completed);
+  }
+}
+
+template<class T, class Key, class Projection>
+void Key_extract_async_task<T, Key, Projection>::_on_error(const std::shared_ptr<std::exception>& error)
+{
+  assert(error != nullptr);
+
+  Async_task::_on_error(error);
+
+  m_tasks_manager->handle_task_completion(get_task_id(), error);
+}
+
+} // My_cpp_libs
+
+#endif // KEY_EXTRACT_ASYNC_TASK_H_0B289531_F2EB_4C87_B450_D647E7FA73A4
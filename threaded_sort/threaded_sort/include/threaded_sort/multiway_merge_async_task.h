@@ -0,0 +1,381 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file multiway_merge_async_task.h
+/// @brief Interface and implementation of the Multiway_merge_async_task<Iterator> class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MULTIWAY_MERGE_ASYNC_TASK_H_9542D1C4_91D1_4118_B5C2_CB04FA141702
+#define MULTIWAY_MERGE_ASYNC_TASK_H_9542D1C4_91D1_4118_B5C2_CB04FA141702
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Multiway_merge_async_task<Iterator>: asynchronous task which merges sorted ranges into piece of output.
+///
+/// Merged ranges are ordered by element and then by index of range (merge is stable). Task finds elements of its
+/// piece itself: every range is split at co-ranks of the first and the last elements of piece (multisequence
+/// selection by binary search), so tasks of neighbouring pieces don't depend on each other. Then elements of
+/// piece are merged by loser tree.
+/// @param <Iterator> Random access iterator of sorted ranges.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class Iterator>
+class Multiway_merge_async_task final : public Async_task
+{
+public:
+
+  // Public types.
+
+  // Type of merged elements.
+  typedef typename std::iterator_traits<Iterator>::value_type Value_type;
+
+  // Sorted range: [first, second).
+  typedef std::pair<Iterator, Iterator> Range;
+
+  // Public methods.
+
+  /// @brief Constructor.
+  /// @param ranges Sorted ranges.
+  /// @param first Index of the first element of piece in output.
+  /// @param last Index of element which follows the last element of piece in output.
+  /// @param output Output vector (size is total count of elements in ranges).
+  /// @param tasks_manager Asynchronous tasks manager.
+  Multiway_merge_async_task(const std::vector<Range>& ranges, int64_t first, int64_t last,
+    std::vector<Value_type>& output, std::shared_ptr<Async_tasks_manager> tasks_manager);
+
+  /// @brief Destructor.
+  virtual ~Multiway_merge_async_task();
+
+  /// @brief Merges piece of output in calling thread.
+  /// @param ranges Sorted ranges.
+  /// @param first Index of the first element of piece in output.
+  /// @param last Index of element which follows the last element of piece in output.
+  /// @param output Output vector (size is total count of elements in ranges).
+  /// @exception bad_alloc
+  /// @exception exception Exception thrown by copy of element.
+  static void merge(const std::vector<Range>& ranges, int64_t first, int64_t last, std::vector<Value_type>& output);
+
+  /// @brief Finds co-rank of every range: count of its elements among the first rank elements of merged ranges.
+  /// @param ranges Sorted ranges.
+  /// @param rank Count of the first elements of merged ranges (not greater than total count of elements).
+  /// @param counts Output: count of elements of every range.
+  /// @exception bad_alloc
+  static void split(const std::vector<Range>& ranges, int64_t rank, std::vector<int64_t>& counts);
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Multiway_merge_async_task(const Multiway_merge_async_task&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Multiway_merge_async_task& operator=(const Multiway_merge_async_task&);
+
+  /// @brief Function which is executed in separate thread.
+  ///        Should not throw exceptions.
+  virtual void _do_in_background() override;
+
+  /// @brief Function called when error occurred.
+  /// @param error Exception occurred on execution.
+  virtual void _on_error(const std::shared_ptr<std::exception>& error) override;
+
+  /// @brief Merges all elements of not empty ranges by loser tree.
+  /// @param ranges Sorted not empty ranges (first iterators are advanced).
+  /// @param output Iterator of the first element of output.
+  /// @exception bad_alloc
+  /// @exception exception Exception thrown by copy of element.
+  static void _merge_by_loser_tree(std::vector<Range>& ranges, typename std::vector<Value_type>::iterator output);
+
+  // Private fields.
+
+  // Sorted ranges.
+  const std::vector<Range>& m_ranges;
+
+  // Index of the first element of piece in output.
+  const int64_t m_first;
+
+  // Index of element which follows the last element of piece in output.
+  const int64_t m_last;
+
+  // Output vector.
+  std::vector<Value_type>& m_output;
+
+  // Asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> m_tasks_manager;
+}; // class Multiway_merge_async_task
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implementation of the Multiway_merge_async_task<Iterator> methods.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Iterator>
+Multiway_merge_async_task<Iterator>::Multiway_merge_async_task(const std::vector<Range>& ranges, int64_t first,
+  int64_t last, std::vector<Value_type>& output, std::shared_ptr<Async_tasks_manager> tasks_manager) :
+    m_ranges(ranges),
+    m_first(first),
+    m_last(last),
+    m_output(output),
+    m_tasks_manager(tasks_manager)
+{
+  assert(first >= 0 && first < last && last <= static_cast<int64_t>(output.size()));
+  assert(tasks_manager != nullptr);
+}
+
+template<class Iterator>
+Multiway_merge_async_task<Iterator>::~Multiway_merge_async_task()
+{
+}
+
+template<class Iterator>
+void Multiway_merge_async_task<Iterator>::merge(const std::vector<Range>& ranges, int64_t first, int64_t last,
+  std::vector<Value_type>& output)
+{
+  assert(first >= 0 && first <= last && last <= static_cast<int64_t>(output.size()));
+
+  if (first == last)
+  {
+    return;
+  }
+
+  std::vector<int64_t> first_counts;
+  std::vector<int64_t> last_counts;
+
+  split(ranges, first, first_counts); // exception
+  split(ranges, last, last_counts); // exception
+
+  // Parts of ranges in piece (order of ranges is kept: it defines order of equal elements).
+  std::vector<Range> pieces;
+
+  for (size_t range = 0; range < ranges.size(); range++)
+  {
+    if (last_counts[range] > first_counts[range])
+    {
+      pieces.push_back(Range(ranges[range].first + first_counts[range],
+        ranges[range].first + last_counts[range])); // exception
+    }
+  }
+
+  assert(!pieces.empty());
+
+  if (pieces.size() == 1)
+  {
+    std::copy(pieces[0].first, pieces[0].second, output.begin() + first); // exception
+
+    return;
+  }
+
+  _merge_by_loser_tree(pieces, output.begin() + first); // exception
+}
+
+template<class Iterator>
+void Multiway_merge_async_task<Iterator>::split(const std::vector<Range>& ranges, int64_t rank,
+  std::vector<int64_t>& counts)
+{
+  const int32_t ranges_count = static_cast<int32_t>(ranges.size());
+
+  // Search windows: co-rank of every range is in [lows[i], highs[i]].
+  std::vector<int64_t> lows(ranges_count, 0); // exception
+  std::vector<int64_t> highs(ranges_count); // exception
+
+  int64_t total_count = 0;
+
+  for (int32_t range = 0; range < ranges_count; range++)
+  {
+    highs[range] = std::distance(ranges[range].first, ranges[range].second);
+
+    total_count += highs[range];
+  }
+
+  assert(rank >= 0 && rank <= total_count);
+
+  if (rank == 0 || rank == total_count)
+  {
+    counts = (rank == 0) ? lows : highs; // exception
+
+    return;
+  }
+
+  std::vector<int64_t> lower_counts(ranges_count); // exception
+  std::vector<int64_t> upper_counts(ranges_count); // exception
+
+  while (true)
+  {
+    // Pivot is the middle element of the widest window: every step halves it at least.
+    int32_t widest_range = 0;
+
+    for (int32_t range = 1; range < ranges_count; range++)
+    {
+      if (highs[range] - lows[range] > highs[widest_range] - lows[widest_range])
+      {
+        widest_range = range;
+      }
+    }
+
+    assert(highs[widest_range] > lows[widest_range]);
+
+    const Value_type& pivot = ranges[widest_range].first[(lows[widest_range] + highs[widest_range]) / 2];
+
+    // Elements before windows are less than pivot, elements after windows are greater.
+    int64_t lower_rank = 0;
+    int64_t upper_rank = 0;
+
+    for (int32_t range = 0; range < ranges_count; range++)
+    {
+      const Iterator first = ranges[range].first;
+
+      lower_counts[range] = std::lower_bound(first + lows[range], first + highs[range], pivot) - first;
+      upper_counts[range] = std::upper_bound(first + lower_counts[range], first + highs[range], pivot) - first;
+
+      lower_rank += lower_counts[range];
+      upper_rank += upper_counts[range];
+    }
+
+    if (rank < lower_rank)
+    {
+      highs.swap(lower_counts);
+    }
+    else if (rank >= upper_rank)
+    {
+      lows.swap(upper_counts);
+    }
+    else
+    {
+      // Elements equal to pivot are taken from ranges in order.
+      int64_t remaining_count = rank - lower_rank;
+
+      for (int32_t range = 0; range < ranges_count; range++)
+      {
+        const int64_t equal_count = std::min(remaining_count, upper_counts[range] - lower_counts[range]);
+
+        lower_counts[range] += equal_count;
+        remaining_count -= equal_count;
+      }
+
+      counts.swap(lower_counts);
+
+      return;
+    }
+  }
+}
+
+template<class Iterator>
+void Multiway_merge_async_task<Iterator>::_do_in_background()
+{
+  bool is_result_ok = true;
+
+  try
+  {
+    merge(m_ranges, m_first, m_last, m_output); // exception
+  }
+  catch (std::exception& error)
+  {
+    std::shared_ptr<std::exception> error_ptr = std::make_shared<std::exception>(error);
+
+    _on_error(error_ptr);
+
+    is_result_ok = false;
+  }
+
+  if (is_result_ok)
+  {
+    m_tasks_manager->handle_task_completion(get_task_id(), nullptr);
+
+    _set_status(Status::completed);
+  }
+}
+
+template<class Iterator>
+void Multiway_merge_async_task<Iterator>::_on_error(const std::shared_ptr<std::exception>& error)
+{
+  assert(error != nullptr);
+
+  Async_task::_on_error(error);
+
+  m_tasks_manager->handle_task_completion(get_task_id(), error);
+}
+
+template<class Iterator>
+void Multiway_merge_async_task<Iterator>::_merge_by_loser_tree(std::vector<Range>& ranges,
+  typename std::vector<Value_type>::iterator output)
+{
+  // Node 0 holds winner, other inner nodes hold losers of their matches.
+  std::vector<int32_t> nodes;
+  std::vector<int32_t> winners;
+
+  // Tree is rebuilt without exhausted range: matches don't check ranges for exhaustion.
+  while (ranges.size() > 1)
+  {
+    const int32_t ranges_count = static_cast<int32_t>(ranges.size());
+
+    // Equal elements are ordered by index of range.
+    auto is_less = [&ranges](int32_t left, int32_t right)
+    {
+      const Value_type& left_element = *ranges[left].first;
+      const Value_type& right_element = *ranges[right].first;
+
+      return (left < right) ? !(right_element < left_element) : (left_element < right_element);
+    };
+
+    // Leaf of range i is node ranges_count + i, children of inner node n are nodes 2 * n and 2 * n + 1.
+    nodes.resize(ranges_count); // exception
+    winners.resize(2 * ranges_count); // exception
+
+    for (int32_t range = 0; range < ranges_count; range++)
+    {
+      winners[ranges_count + range] = range;
+    }
+
+    for (int32_t node = ranges_count - 1; node > 0; node--)
+    {
+      const int32_t left = winners[2 * node];
+      const int32_t right = winners[2 * node + 1];
+
+      const bool is_right_winner = is_less(right, left);
+
+      winners[node] = is_right_winner ? right : left;
+      nodes[node] = is_right_winner ? left : right;
+    }
+
+    nodes[0] = winners[1];
+
+    while (true)
+    {
+      int32_t winner = nodes[0];
+
+      Range& winner_range = ranges[winner];
+
+      *output = *winner_range.first; // exception
+
+      ++output;
+      ++winner_range.first;
+
+      if (winner_range.first == winner_range.second)
+      {
+        ranges.erase(ranges.begin() + winner);
+
+        break;
+      }
+
+      // Replay matches on path from leaf of winner to root (selection instead of branch).
+      for (int32_t node = (ranges_count + winner) / 2; node > 0; node /= 2)
+      {
+        const int32_t loser = nodes[node];
+
+        const bool is_loser_winner = is_less(loser, winner);
+
+        nodes[node] = is_loser_winner ? winner : loser;
+        winner = is_loser_winner ? loser : winner;
+      }
+
+      nodes[0] = winner;
+    }
+  }
+
+  std::copy(ranges[0].first, ranges[0].second, output); // exception
+}
+
+} // My_cpp_libs
+
+#endif // MULTIWAY_MERGE_ASYNC_TASK_H_9542D1C4_91D1_4118_B5C2_CB04FA141702
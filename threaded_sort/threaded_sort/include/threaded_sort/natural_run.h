@@ -0,0 +1,37 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file natural_run.h
+/// @brief Interface and implementation of the Natural_run struct.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NATURAL_RUN_H_6C5258B5_19C3_48DA_97B5_EB34FF676697
+#define NATURAL_RUN_H_6C5258B5_19C3_48DA_97B5_EB34FF676697
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct Natural_run: range of vector which is already ordered: not descending or strictly descending.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Natural_run
+{
+  /// @brief Gets count of elements in run.
+  int32_t get_size() const
+  {
+    return (last - first);
+  }
+
+  // Index of the first element of run.
+  int32_t first;
+
+  // Index of element which follows the last element of run.
+  int32_t last;
+
+  // Flag: elements are strictly descending (run should be reversed).
+  bool is_descending;
+}; // struct Natural_run
+
+} // My_cpp_libs
+
+#endif // NATURAL_RUN_H_6C5258B5_19C3_48DA_97B5_EB34FF676697
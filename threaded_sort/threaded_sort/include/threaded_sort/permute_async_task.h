@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file permute_async_task.h
+/// @brief Interface and implementation of the Permute_async_task<T> class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PERMUTE_ASYNC_TASK_H_21D492A3_EEF1_464D_86CB_57B05E2E6142
+#define PERMUTE_ASYNC_TASK_H_21D492A3_EEF1_464D_86CB_57B05E2E6142
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Permute_async_task<T>: asynchronous task which moves elements into final position after indirect
+///        sort by following cycles of permutation in place (every element is moved once).
+///
+/// Cycles are listed one after another in order array: cycle [s, e) means vector[order[k]] = vector[order[k + 1]]
+/// for k in [s, e - 1) and vector[order[e - 1]] = original vector[order[s]]. Order array is split into chunks
+/// permuted in parallel. Elements which are read by one chunk and overwritten by another one (first element
+/// of chunk inside cycle and start of cycle which crosses chunks boundary) are saved before tasks are started,
+/// so chunks are independent. Elements should be nothrow move constructible and assignable.
+/// @param <T> Type of elements in vector.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class Permute_async_task final : public Async_task
+{
+public:
+
+  /// @brief Constructor.
+  /// @param vector Reference to vector which is permuted.
+  /// @param order Indices of vector elements in order of cycles.
+  /// @param cycle_starts Positions in order array where cycles start (the last one is size of order array).
+  /// @param saved_positions Sorted positions in order array which elements are saved.
+  /// @param saved_elements Saved elements (saved_elements[i] is element at saved_positions[i]).
+  /// @param first Position in order array from which chunk is started.
+  /// @param last Position in order array which follows the last position of chunk.
+  /// @param tasks_manager Asynchronous tasks manager.
+  Permute_async_task(std::vector<T>& vector, const Workspace_vector<int32_t>& order,
+    const Workspace_vector<int32_t>& cycle_starts, const Workspace_vector<int32_t>& saved_positions, T* saved_elements,
+    int32_t first, int32_t last, std::shared_ptr<Async_tasks_manager> tasks_manager);
+
+  /// @brief Destructor.
+  virtual ~Permute_async_task();
+
+  /// @brief Permutes chunk in calling thread (used if task can't be started).
+  void permute();
+
+  /// @brief Permutes chunk in calling thread.
+  /// @param vector Reference to vector which is permuted.
+  /// @param order Indices of vector elements in order of cycles.
+  /// @param cycle_starts Positions in order array where cycles start (the last one is size of order array).
+  /// @param saved_positions Sorted positions in order array which elements are saved.
+  /// @param saved_elements Saved elements.
+  /// @param first Position in order array from which chunk is started.
+  /// @param last Position in order array which follows the last position of chunk.
+  static void permute(std::vector<T>& vector, const Workspace_vector<int32_t>& order,
+    const Workspace_vector<int32_t>& cycle_starts, const Workspace_vector<int32_t>& saved_positions, T* saved_elements,
+    int32_t first, int32_t last);
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Permute_async_task(const Permute_async_task&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Permute_async_task& operator=(const Permute_async_task&);
+
+  /// @brief Function which is executed in separate thread.
+  ///        Should not throw exceptions.
+  virtual void _do_in_background() override;
+
+  /// @brief Function called when error occurred (task can't be started).
+  /// @param error Exception occurred on execution.
+  virtual void _on_error(const std::shared_ptr<std::exception>& error) override;
+
+  // Private fields.
+
+  // Reference to vector which is permuted.
+  std::vector<T>& m_vector;
+
+  // Indices of vector elements in order of cycles.
+  const Workspace_vector<int32_t>& m_order;
+
+  // Positions in order array where cycles start.
+  const Workspace_vector<int32_t>& m_cycle_starts;
+
+  // Sorted positions in order array which elements are saved.
+  const Workspace_vector<int32_t>& m_saved_positions;
+
+  // Saved elements.
+  T* const m_saved_elements;
+
+  // Position in order array from which chunk is started.
+  const int32_t m_first;
+
+  // Position in order array which follows the last position of chunk.
+  const int32_t m_last;
+
+  // Asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> m_tasks_manager;
+}; // class Permute_async_task
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implementation of the Permute_async_task<T> methods.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+Permute_async_task<T>::Permute_async_task(std::vector<T>& vector, const Workspace_vector<int32_t>& order,
+  const Workspace_vector<int32_t>& cycle_starts, const Workspace_vector<int32_t>& saved_positions, T* saved_elements,
+  int32_t first, int32_t last, std::shared_ptr<Async_tasks_manager> tasks_manager) :
+    m_vector(vector),
+    m_order(order),
+    m_cycle_starts(cycle_starts),
+    m_saved_positions(saved_positions),
+    m_saved_elements(saved_elements),
+    m_first(first),
+    m_last(last),
+    m_tasks_manager(tasks_manager)
+{
+  assert(first >= 0 && first < last && last <= static_cast<int32_t>(order.size()));
+  assert(tasks_manager != nullptr);
+}
+
+template<class T>
+Permute_async_task<T>::~Permute_async_task()
+{
+}
+
+template<class T>
+void Permute_async_task<T>::permute()
+{
+  permute(m_vector, m_order, m_cycle_starts, m_saved_positions, m_saved_elements, m_first, m_last);
+}
+
+template<class T>
+void Permute_async_task<T>::permute(std::vector<T>& vector, const Workspace_vector<int32_t>& order,
+  const Workspace_vector<int32_t>& cycle_starts, const Workspace_vector<int32_t>& saved_positions, T* saved_elements,
+  int32_t first, int32_t last)
+{
+  static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+    "Elements should be nothrow movable.");
+
+  assert(first >= 0 && first <= last && last <= static_cast<int32_t>(order.size()));
+  assert(!cycle_starts.empty() && cycle_starts.back() == static_cast<int32_t>(order.size()));
+
+  // Gets element which should be moved to order[position - 1] (or to the end of cycle).
+  auto get_source = [&](int32_t position) -> T&
+  {
+    Workspace_vector<int32_t>::const_iterator saved_position = std::lower_bound(saved_positions.begin(),
+      saved_positions.end(), position);
+
+    if (saved_position != saved_positions.end() && *saved_position == position)
+    {
+      return saved_elements[saved_position - saved_positions.begin()];
+    }
+
+    return vector[order[position]];
+  };
+
+  // Cycle which contains the first position of chunk.
+  size_t cycle = std::upper_bound(cycle_starts.begin(), cycle_starts.end(), first) - cycle_starts.begin() - 1;
+
+  int32_t k = first;
+
+  while (k < last)
+  {
+    const int32_t start = cycle_starts[cycle];
+    const int32_t end = cycle_starts[cycle + 1];
+
+    if (start >= first && end <= last)
+    {
+      // Cycle inside chunk: classic cycle following with one temporary element.
+      T element = std::move(vector[order[start]]);
+
+      for (; k + 1 < end; k++)
+      {
+        vector[order[k]] = std::move(vector[order[k + 1]]);
+      }
+
+      vector[order[k]] = std::move(element);
+
+      k++;
+    }
+    else
+    {
+      // Part of cycle which crosses chunks boundary: elements owned by other chunks are saved.
+      const int32_t chunk_end = std::min(end, last);
+
+      for (; k < chunk_end; k++)
+      {
+        if (k + 1 == end)
+        {
+          vector[order[k]] = std::move(get_source(start));
+        }
+        else if (k + 1 == last)
+        {
+          vector[order[k]] = std::move(get_source(k + 1));
+        }
+        else
+        {
+          vector[order[k]] = std::move(vector[order[k + 1]]);
+        }
+      }
+    }
+
+    cycle++;
+  }
+}
+
+template<class T>
+void Permute_async_task<T>::_do_in_background()
+{
+  permute();
+
+  m_tasks_manager->handle_task_completion(get_task_id(), nullptr);
+
+  _set_status(Status::completed);
+}
+
+template<class T>
+void Permute_async_task<T>::_on_error(const std::shared_ptr<std::exception>& error)
+{
+  assert(error != nullptr);
+
+  Async_task::_on_error(error);
+
+  m_tasks_manager->handle_task_completion(get_task_id(), error);
+}
+
+} // My_cpp_libs
+
+#endif // PERMUTE_ASYNC_TASK_H_21D492A3_EEF1_464D_86CB_57B05E2E6142
@@ -0,0 +1,327 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file reduce_async_task.h
+/// @brief Interface and implementation of the Reduce_chunk struct and the Reduce_async_task<T, Reduce> class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef REDUCE_ASYNC_TASK_H_22478607_5993_4B69_8F61_3CD1E33E0C9D
+#define REDUCE_ASYNC_TASK_H_22478607_5993_4B69_8F61_3CD1E33E0C9D
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct Reduce_chunk: chunk of sorted vector which groups of equal elements are reduced by one task.
+///        Chunk boundaries are starts of groups: groups are never split between chunks.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Reduce_chunk
+{
+  /// @brief Stage of processing of chunk.
+  enum class Stage
+  {
+    reduce,  // Reduces every group of equal elements into its first element, results are moved to chunk start.
+    save,    // Moves results of chunk into saved elements.
+    restore  // Moves saved results of chunk into output position.
+  };
+
+  // Public methods.
+
+  /// @brief Splits sorted vector into chunks of nearly equal size: boundaries are moved back to starts of groups
+  ///        of equal elements (chunk may become empty).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Sorted vector (not empty).
+  /// @param chunks_count Count of chunks (positive).
+  /// @param chunks Output: chunks (count is not set).
+  /// @exception bad_alloc
+  /// @exception exception Exception thrown by comparison of elements.
+  template<class T>
+  static void split(const std::vector<T>& vector, int32_t chunks_count, std::vector<Reduce_chunk>& chunks)
+  {
+    const int32_t size = static_cast<int32_t>(vector.size());
+
+    assert(size > 0 && chunks_count > 0);
+
+    chunks.resize(chunks_count); // exception
+
+    for (int32_t chunk = 0; chunk < chunks_count; chunk++)
+    {
+      chunks[chunk].first = (chunk > 0) ? chunks[chunk - 1].last : 0;
+      chunks[chunk].last = size;
+
+      if (chunk + 1 < chunks_count)
+      {
+        const int32_t boundary = static_cast<int32_t>(static_cast<int64_t>(size) * (chunk + 1) / chunks_count);
+
+        chunks[chunk].last = static_cast<int32_t>(std::lower_bound(vector.begin() + chunks[chunk].first,
+          vector.begin() + boundary, vector[boundary]) - vector.begin()); // exception
+      }
+    }
+  }
+
+  /// @brief Sets output positions of results of reduced chunks: only results of chunks after the first shortened
+  ///        chunk are moved.
+  /// @param chunks Reduced chunks (count is set).
+  /// @param moved_count Output: count of results which are moved (saved elements are needed for them).
+  /// @return Count of results of all chunks.
+  static int32_t set_outputs(std::vector<Reduce_chunk>& chunks, int32_t& moved_count)
+  {
+    int32_t results_count = 0;
+
+    moved_count = 0;
+
+    for (Reduce_chunk& chunk : chunks)
+    {
+      chunk.output = results_count;
+      chunk.saved_first = moved_count;
+
+      results_count += chunk.count;
+
+      if (chunk.output != chunk.first)
+      {
+        moved_count += chunk.count;
+      }
+    }
+
+    return results_count;
+  }
+
+  // Public fields.
+
+  // Index of the first element of chunk.
+  int32_t first;
+
+  // Index of element which follows the last element of chunk.
+  int32_t last;
+
+  // Count of results of chunk (count of groups).
+  int32_t count;
+
+  // Index of the first result of chunk in compacted vector.
+  int32_t output;
+
+  // Index of the first saved result of chunk.
+  int32_t saved_first;
+}; // struct Reduce_chunk
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Reduce_async_task<T, Reduce>: asynchronous task which executes one stage of reduction of groups
+///        of equal elements in chunk of sorted vector.
+///
+/// Groups are reduced right after sort in one pass over chunk, results are compacted at chunk start. Then results
+/// of all chunks are compacted: results which are moved to the left are saved by chunks in parallel and then moved
+/// into output position by chunks in parallel (output of chunk may overlap results of previous chunks).
+/// @param <T> Type of elements in vector.
+/// @param <Reduce> Function void(T& result, const T& element) which adds element into result of group
+///        (should not change order of result).
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T, class Reduce>
+class Reduce_async_task final : public Async_task
+{
+public:
+
+  /// @brief Constructor.
+  /// @param vector Reference to sorted vector.
+  /// @param chunk Chunk (count is set by reduce stage).
+  /// @param reduce Reduce function (copied).
+  /// @param saved_elements Saved results of all chunks (used by save and restore stages).
+  /// @param stage Stage of processing of chunk.
+  /// @param tasks_manager Asynchronous tasks manager.
+  Reduce_async_task(std::vector<T>& vector, Reduce_chunk& chunk, const Reduce& reduce, T* saved_elements,
+    Reduce_chunk::Stage stage, std::shared_ptr<Async_tasks_manager> tasks_manager);
+
+  /// @brief Destructor.
+  virtual ~Reduce_async_task();
+
+  /// @brief Executes stage in calling thread (used if task can't be started).
+  /// @exception exception Exception thrown by comparison or reduction of elements.
+  void execute_stage();
+
+  /// @brief Executes stage of processing of chunk in calling thread.
+  /// @param vector Reference to sorted vector.
+  /// @param chunk Chunk (count is set by reduce stage).
+  /// @param reduce Reduce function.
+  /// @param saved_elements Saved results of all chunks (used by save and restore stages).
+  /// @param stage Stage of processing of chunk.
+  /// @exception exception Exception thrown by comparison or reduction of elements.
+  static void execute_stage(std::vector<T>& vector, Reduce_chunk& chunk, Reduce& reduce, T* saved_elements,
+    Reduce_chunk::Stage stage);
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Reduce_async_task(const Reduce_async_task&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Reduce_async_task& operator=(const Reduce_async_task&);
+
+  /// @brief Function which is executed in separate thread.
+  ///        Should not throw exceptions.
+  virtual void _do_in_background() override;
+
+  /// @brief Function called when error occurred.
+  /// @param error Exception occurred on execution.
+  virtual void _on_error(const std::shared_ptr<std::exception>& error) override;
+
+  // Private fields.
+
+  // Reference to sorted vector.
+  std::vector<T>& m_vector;
+
+  // Chunk.
+  Reduce_chunk& m_chunk;
+
+  // Reduce function.
+  Reduce m_reduce;
+
+  // Saved results of all chunks.
+  T* const m_saved_elements;
+
+  // Stage of processing of chunk.
+  const Reduce_chunk::Stage m_stage;
+
+  // Asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> m_tasks_manager;
+}; // class Reduce_async_task
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implementation of the Reduce_async_task<T, Reduce> methods.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class T, class Reduce>
+Reduce_async_task<T, Reduce>::Reduce_async_task(std::vector<T>& vector, Reduce_chunk& chunk, const Reduce& reduce,
+  T* saved_elements, Reduce_chunk::Stage stage, std::shared_ptr<Async_tasks_manager> tasks_manager) :
+    m_vector(vector),
+    m_chunk(chunk),
+    m_reduce(reduce),
+    m_saved_elements(saved_elements),
+    m_stage(stage),
+    m_tasks_manager(tasks_manager)
+{
+  assert(chunk.first >= 0 && chunk.first <= chunk.last && chunk.last <= static_cast<int32_t>(vector.size()));
+  assert(tasks_manager != nullptr);
+}
+
+template<class T, class Reduce>
+Reduce_async_task<T, Reduce>::~Reduce_async_task()
+{
+}
+
+template<class T, class Reduce>
+void Reduce_async_task<T, Reduce>::execute_stage()
+{
+  execute_stage(m_vector, m_chunk, m_reduce, m_saved_elements, m_stage); // exception
+}
+
+template<class T, class Reduce>
+void Reduce_async_task<T, Reduce>::execute_stage(std::vector<T>& vector, Reduce_chunk& chunk, Reduce& reduce,
+  T* saved_elements, Reduce_chunk::Stage stage)
+{
+  assert(chunk.first >= 0 && chunk.first <= chunk.last && chunk.last <= static_cast<int32_t>(vector.size()));
+
+  switch (stage)
+  {
+  case Reduce_chunk::Stage::reduce:
+    {
+      chunk.count = 0;
+
+      if (chunk.first == chunk.last)
+      {
+        break;
+      }
+
+      // Vector is sorted: element which is not greater than result of group is equal to it.
+      int32_t result = chunk.first;
+
+      for (int32_t i = chunk.first + 1; i < chunk.last; i++)
+      {
+        if (vector[result] < vector[i]) // exception
+        {
+          if (++result != i)
+          {
+            vector[result] = std::move(vector[i]); // exception
+          }
+        }
+        else
+        {
+          reduce(vector[result], vector[i]); // exception
+        }
+      }
+
+      chunk.count = result - chunk.first + 1;
+    }
+    break;
+
+  case Reduce_chunk::Stage::save:
+    // Results which are already in output position are not moved.
+    if (chunk.output == chunk.first)
+    {
+      break;
+    }
+
+    for (int32_t i = 0; i < chunk.count; i++)
+    {
+      new (&saved_elements[chunk.saved_first + i]) T(std::move(vector[chunk.first + i]));
+    }
+    break;
+
+  case Reduce_chunk::Stage::restore:
+    if (chunk.output == chunk.first)
+    {
+      break;
+    }
+
+    for (int32_t i = 0; i < chunk.count; i++)
+    {
+      T& saved_element = saved_elements[chunk.saved_first + i];
+
+      vector[chunk.output + i] = std::move(saved_element);
+
+      saved_element.~T();
+    }
+    break;
+  }
+}
+
+template<class T, class Reduce>
+void Reduce_async_task<T, Reduce>::_do_in_background()
+{
+  bool is_result_ok = true;
+
+  try
+  {
+    execute_stage(); // exception
+  }
+  catch (std::exception& error)
+  {
+    std::shared_ptr<std::exception> error_ptr = std::make_shared<std::exception>(error);
+
+    _on_error(error_ptr);
+
+    is_result_ok = false;
+  }
+
+  if (is_result_ok)
+  {
+    m_tasks_manager->handle_task_completion(get_task_id(), nullptr);
+
+    _set_status(Status::completed);
+  }
+}
+
+template<class T, class Reduce>
+void Reduce_async_task<T, Reduce>::_on_error(const std::shared_ptr<std::exception>& error)
+{
+  assert(error != nullptr);
+
+  Async_task::_on_error(error);
+
+  m_tasks_manager->handle_task_completion(get_task_id(), error);
+}
+
+} // My_cpp_libs
+
+#endif // REDUCE_ASYNC_TASK_H_22478607_5993_4B69_8F61_3CD1E33E0C9D
@@ -0,0 +1,309 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file run_merge_async_task.h
+/// @brief Interface and implementation of the Run_merge_job struct and the Run_merge_async_task<T> class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RUN_MERGE_ASYNC_TASK_H_A7B68222_777E_47C8_AF77_59E5D0379D00
+#define RUN_MERGE_ASYNC_TASK_H_A7B68222_777E_47C8_AF77_59E5D0379D00
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct Run_merge_job: job of adaptive sort executed by Run_merge_async_task<T>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Run_merge_job
+{
+  /// @brief Operation of job.
+  enum class Operation
+  {
+    reverse, // Reverses range [first, last).
+    sort,    // Sorts range [first, last).
+    merge    // Merges sorted ranges [first, middle) and [middle, last).
+  };
+
+  // Operation of job.
+  Operation operation;
+
+  // Index of the first element of range.
+  int32_t first;
+
+  // Index of the first element of the second range (used by merge).
+  int32_t middle;
+
+  // Index of element which follows the last element of range.
+  int32_t last;
+}; // struct Run_merge_job
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Run_merge_async_task<T>: asynchronous task which sequentially executes batch of independent jobs
+///        of adaptive sort: reversal of descending runs, sort of ranges without long runs and merge of
+///        neighbouring sorted ranges.
+///
+/// Merge of range [first, last) uses elements [first / 2, first / 2 + (last - first) / 2) of merge buffer: buffers
+/// of jobs with not intersecting ranges don't intersect, so one buffer of size / 2 elements serves a whole level
+/// of merge tree.
+/// @param <T> Type of elements in vector.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class Run_merge_async_task final : public Async_task
+{
+public:
+
+  /// @brief Constructor.
+  /// @param vector Reference to vector which is sorted.
+  /// @param jobs Jobs (ranges of jobs should not intersect).
+  /// @param first_job Index of the first job of batch.
+  /// @param last_job Index of job which follows the last job of batch.
+  /// @param merge_buffer Uninitialized memory for vector.size() / 2 elements (null: merges use std::inplace_merge).
+  /// @param tasks_manager Asynchronous tasks manager.
+  Run_merge_async_task(std::vector<T>& vector, const std::vector<Run_merge_job>& jobs, int32_t first_job,
+    int32_t last_job, T* merge_buffer, std::shared_ptr<Async_tasks_manager> tasks_manager);
+
+  /// @brief Destructor.
+  virtual ~Run_merge_async_task();
+
+  /// @brief Executes job in calling thread.
+  /// @param vector Reference to vector which is sorted.
+  /// @param job Job.
+  /// @param merge_buffer Uninitialized memory for vector.size() / 2 elements (null: merges use std::inplace_merge).
+  static void execute_job(std::vector<T>& vector, const Run_merge_job& job, T* merge_buffer);
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Run_merge_async_task(const Run_merge_async_task&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Run_merge_async_task& operator=(const Run_merge_async_task&);
+
+  /// @brief Function which is executed in separate thread.
+  ///        Should not throw exceptions.
+  virtual void _do_in_background() override;
+
+  /// @brief Function called when error occurred.
+  /// @param error Exception occurred on execution.
+  virtual void _on_error(const std::shared_ptr<std::exception>& error) override;
+
+  /// @brief Merges sorted ranges [first, middle) and [middle, last) through buffer: the shorter range is moved
+  ///        into buffer and merged with the other one from the side which is free (stable).
+  /// @param first Iterator of the first element of the left range.
+  /// @param middle Iterator of the first element of the right range.
+  /// @param last Iterator of element which follows the last element of the right range.
+  /// @param buffer Uninitialized memory for (last - first) / 2 elements.
+  static void _merge(typename std::vector<T>::iterator first, typename std::vector<T>::iterator middle,
+    typename std::vector<T>::iterator last, T* buffer);
+
+  // Private fields.
+
+  // Reference to vector which is sorted.
+  std::vector<T>& m_vector;
+
+  // Jobs.
+  const std::vector<Run_merge_job>& m_jobs;
+
+  // Index of the first job of batch.
+  const int32_t m_first_job;
+
+  // Index of job which follows the last job of batch.
+  const int32_t m_last_job;
+
+  // Merge buffer (may be null).
+  T* const m_merge_buffer;
+
+  // Asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> m_tasks_manager;
+}; // class Run_merge_async_task
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implementation of the Run_merge_async_task<T> methods.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+Run_merge_async_task<T>::Run_merge_async_task(std::vector<T>& vector, const std::vector<Run_merge_job>& jobs,
+  int32_t first_job, int32_t last_job, T* merge_buffer, std::shared_ptr<Async_tasks_manager> tasks_manager) :
+    m_vector(vector),
+    m_jobs(jobs),
+    m_first_job(first_job),
+    m_last_job(last_job),
+    m_merge_buffer(merge_buffer),
+    m_tasks_manager(tasks_manager)
+{
+  assert(first_job >= 0 && first_job < last_job && last_job <= static_cast<int32_t>(jobs.size()));
+  assert(tasks_manager != nullptr);
+}
+
+template<class T>
+Run_merge_async_task<T>::~Run_merge_async_task()
+{
+}
+
+template<class T>
+void Run_merge_async_task<T>::execute_job(std::vector<T>& vector, const Run_merge_job& job, T* merge_buffer)
+{
+  assert(job.first >= 0 && job.first <= job.middle && job.middle <= job.last);
+  assert(job.last <= static_cast<int32_t>(vector.size()));
+
+  const typename std::vector<T>::iterator first = vector.begin() + job.first;
+  const typename std::vector<T>::iterator last = vector.begin() + job.last;
+
+  switch (job.operation)
+  {
+  case Run_merge_job::Operation::reverse:
+    std::reverse(first, last);
+    break;
+
+  case Run_merge_job::Operation::sort:
+    std::sort(first, last);
+    break;
+
+  case Run_merge_job::Operation::merge:
+    if (merge_buffer != nullptr)
+    {
+      _merge(first, vector.begin() + job.middle, last, merge_buffer + job.first / 2); // exception
+    }
+    else
+    {
+      // Uses temporary buffer if it can be allocated, otherwise merges in place.
+      std::inplace_merge(first, vector.begin() + job.middle, last);
+    }
+    break;
+  }
+}
+
+template<class T>
+void Run_merge_async_task<T>::_do_in_background()
+{
+  bool is_result_ok = true;
+
+  try
+  {
+    for (int32_t job = m_first_job; job < m_last_job; job++)
+    {
+      if (m_tasks_manager->is_error_occurred())
+      {
+        break;
+      }
+
+      execute_job(m_vector, m_jobs[job], m_merge_buffer); // exception
+    }
+  }
+  catch (std::exception& error)
+  {
+    std::shared_ptr<std::exception> error_ptr = std::make_shared<std::exception>(error);
+
+    _on_error(error_ptr);
+
+    is_result_ok = false;
+  }
+
+  if (is_result_ok)
+  {
+    m_tasks_manager->handle_task_completion(get_task_id(), nullptr);
+
+    _set_status(Status::completed);
+  }
+}
+
+template<class T>
+void Run_merge_async_task<T>::_on_error(const std::shared_ptr<std::exception>& error)
+{
+  assert(error != nullptr);
+
+  Async_task::_on_error(error);
+
+  m_tasks_manager->handle_task_completion(get_task_id(), error);
+}
+
+template<class T>
+void Run_merge_async_task<T>::_merge(typename std::vector<T>::iterator first,
+  typename std::vector<T>::iterator middle, typename std::vector<T>::iterator last, T* buffer)
+{
+  assert(buffer != nullptr);
+
+  const int64_t left_size = middle - first;
+  const int64_t right_size = last - middle;
+
+  if (left_size == 0 || right_size == 0)
+  {
+    return;
+  }
+
+  // Moved elements are destroyed on return, also if comparison throws (vector keeps moved-from elements then).
+  T* const buffer_first = buffer;
+  T* buffer_last = buffer;
+
+  auto destroy = [&buffer_last](T* elements)
+  {
+    for (T* element = elements; element != buffer_last; ++element)
+    {
+      element->~T();
+    }
+  };
+
+  std::unique_ptr<T, decltype(destroy)> buffer_guard(buffer_first, destroy);
+
+  if (left_size <= right_size)
+  {
+    // Left range is moved out: merge goes forward, elements of buffer win ties.
+    buffer_last = std::uninitialized_move(first, middle, buffer_first); // exception
+
+    T* left = buffer_first;
+    typename std::vector<T>::iterator right = middle;
+    typename std::vector<T>::iterator output = first;
+
+    while (left != buffer_last && right != last)
+    {
+      if (*right < *left) // exception
+      {
+        *output = std::move(*right);
+        ++right;
+      }
+      else
+      {
+        *output = std::move(*left);
+        ++left;
+      }
+
+      ++output;
+    }
+
+    std::move(left, buffer_last, output);
+  }
+  else
+  {
+    // Right range is moved out: merge goes backward, elements of buffer win ties.
+    buffer_last = std::uninitialized_move(middle, last, buffer_first); // exception
+
+    T* right = buffer_last;
+    typename std::vector<T>::iterator left = middle;
+    typename std::vector<T>::iterator output = last;
+
+    while (right != buffer_first && left != first)
+    {
+      --output;
+
+      if (*(right - 1) < *(left - 1)) // exception
+      {
+        --left;
+        *output = std::move(*left);
+      }
+      else
+      {
+        --right;
+        *output = std::move(*right);
+      }
+    }
+
+    std::move_backward(buffer_first, right, output);
+  }
+}
+
+} // My_cpp_libs
+
+#endif // RUN_MERGE_ASYNC_TASK_H_A7B68222_777E_47C8_AF77_59E5D0379D00
@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file run_scan_async_task.h
+/// @brief Interface and implementation of the Run_scan_async_task<T> class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RUN_SCAN_ASYNC_TASK_H_0C4CF5C4_07CD_440E_AFC7_394266C8F4BE
+#define RUN_SCAN_ASYNC_TASK_H_0C4CF5C4_07CD_440E_AFC7_394266C8F4BE
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Run_scan_async_task<T>: asynchronous task which splits chunk of vector into natural runs.
+///        Only long runs are listed (short ones are sorted as unordered ranges), but the first and the last runs
+///        of chunk are always listed: runs of neighbouring chunks are joined by caller.
+/// @param <T> Type of elements in vector.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class Run_scan_async_task final : public Async_task
+{
+public:
+
+  /// @brief Constructor.
+  /// @param vector Reference to vector which is scanned.
+  /// @param first Index of the first element of chunk.
+  /// @param last Index of element which follows the last element of chunk.
+  /// @param min_run_length Minimum count of elements in listed run.
+  /// @param runs Output: natural runs of chunk.
+  /// @param tasks_manager Asynchronous tasks manager.
+  Run_scan_async_task(const std::vector<T>& vector, int32_t first, int32_t last, int32_t min_run_length,
+    std::vector<Natural_run>& runs, std::shared_ptr<Async_tasks_manager> tasks_manager);
+
+  /// @brief Destructor.
+  virtual ~Run_scan_async_task();
+
+  /// @brief Splits chunk of vector into natural runs in calling thread.
+  /// @param vector Reference to vector which is scanned.
+  /// @param first Index of the first element of chunk.
+  /// @param last Index of element which follows the last element of chunk.
+  /// @param min_run_length Minimum count of elements in listed run.
+  /// @param runs Output: natural runs of chunk.
+  /// @exception std::bad_alloc
+  static void scan(const std::vector<T>& vector, int32_t first, int32_t last, int32_t min_run_length,
+    std::vector<Natural_run>& runs);
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Run_scan_async_task(const Run_scan_async_task&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Run_scan_async_task& operator=(const Run_scan_async_task&);
+
+  /// @brief Function which is executed in separate thread.
+  ///        Should not throw exceptions.
+  virtual void _do_in_background() override;
+
+  /// @brief Function called when error occurred.
+  /// @param error Exception occurred on execution.
+  virtual void _on_error(const std::shared_ptr<std::exception>& error) override;
+
+  // Private fields.
+
+  // Reference to vector which is scanned.
+  const std::vector<T>& m_vector;
+
+  // Index of the first element of chunk.
+  const int32_t m_first;
+
+  // Index of element which follows the last element of chunk.
+  const int32_t m_last;
+
+  // Minimum count of elements in listed run.
+  const int32_t m_min_run_length;
+
+  // Natural runs of chunk.
+  std::vector<Natural_run>& m_runs;
+
+  // Asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> m_tasks_manager;
+}; // class Run_scan_async_task
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implementation of the Run_scan_async_task<T> methods.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+Run_scan_async_task<T>::Run_scan_async_task(const std::vector<T>& vector, int32_t first, int32_t last,
+  int32_t min_run_length, std::vector<Natural_run>& runs, std::shared_ptr<Async_tasks_manager> tasks_manager) :
+    m_vector(vector),
+    m_first(first),
+    m_last(last),
+    m_min_run_length(min_run_length),
+    m_runs(runs),
+    m_tasks_manager(tasks_manager)
+{
+  assert(first >= 0 && first < last && last <= static_cast<int32_t>(vector.size()));
+  assert(tasks_manager != nullptr);
+}
+
+template<class T>
+Run_scan_async_task<T>::~Run_scan_async_task()
+{
+}
+
+template<class T>
+void Run_scan_async_task<T>::scan(const std::vector<T>& vector, int32_t first, int32_t last,
+  int32_t min_run_length, std::vector<Natural_run>& runs)
+{
+  assert(first >= 0 && first <= last && last <= static_cast<int32_t>(vector.size()));
+
+  int32_t i = first;
+
+  while (i < last)
+  {
+    Natural_run run = { i, i + 1, false };
+
+    if (run.last < last && vector[run.last] < vector[i])
+    {
+      // Strictly descending run (equal elements are not reordered by reversal).
+      run.is_descending = true;
+
+      while (run.last < last && vector[run.last] < vector[run.last - 1])
+      {
+        run.last++;
+      }
+    }
+    else
+    {
+      while (run.last < last && !(vector[run.last] < vector[run.last - 1]))
+      {
+        run.last++;
+      }
+    }
+
+    if (run.get_size() >= min_run_length || run.first == first || run.last == last)
+    {
+      runs.push_back(run); // exception
+    }
+
+    i = run.last;
+  }
+}
+
+template<class T>
+void Run_scan_async_task<T>::_do_in_background()
+{
+  bool is_result_ok = true;
+
+  try
+  {
+    scan(m_vector, m_first, m_last, m_min_run_length, m_runs); // exception
+  }
+  catch (std::exception& error)
+  {
+    std::shared_ptr<std::exception> error_ptr = std::make_shared<std::exception>(error);
+
+    _on_error(error_ptr);
+
+    is_result_ok = false;
+  }
+
+  if (is_result_ok)
+  {
+    m_tasks_manager->handle_task_completion(get_task_id(), nullptr);
+
+    _set_status(Status::completed);
+  }
+}
+
+template<class T>
+void Run_scan_async_task<T>::_on_error(const std::shared_ptr<std::exception>& error)
+{
+  assert(error != nullptr);
+
+  Async_task::_on_error(error);
+
+  m_tasks_manager->handle_task_completion(get_task_id(), error);
+}
+
+} // My_cpp_libs
+
+#endif // RUN_SCAN_ASYNC_TASK_H_0C4CF5C4_07CD_440E_AFC7_394266C8F4BE
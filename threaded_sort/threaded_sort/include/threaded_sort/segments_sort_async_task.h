@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file segments_sort_async_task.h
+/// @brief Interface and implementation of the Segments_sort_async_task<T> class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SEGMENTS_SORT_ASYNC_TASK_H_7F3E0A95_D21C_4B68_8E4F_A5C07B19D263
+#define SEGMENTS_SORT_ASYNC_TASK_H_7F3E0A95_D21C_4B68_8E4F_A5C07B19D263
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Segments_sort_async_task<T>: asynchronous task which sequentially sorts batch of small segments.
+///        Segments not smaller than large segment size are skipped: they are sorted by Sort_async_task.
+/// @param <T> Type of elements in vector.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class Segments_sort_async_task final : public Async_task
+{
+public:
+
+  /// @brief Constructor.
+  /// @param vector Reference to vector which segments should be sorted.
+  /// @param offsets Offsets of segments: segment i is [offsets[i], offsets[i + 1]).
+  /// @param first_segment Index of the first segment in batch.
+  /// @param last_segment Index of segment which encloses batch.
+  /// @param large_segment_size Segments with this or bigger size are skipped.
+  /// @param tasks_manager Asynchronous tasks manager.
+  Segments_sort_async_task(std::vector<T>& vector, const std::vector<int32_t>& offsets, int32_t first_segment,
+    int32_t last_segment, int32_t large_segment_size, std::shared_ptr<Async_tasks_manager> tasks_manager);
+
+  /// @brief Destructor.
+  virtual ~Segments_sort_async_task();
+
+  /// @brief Sorts small segment in calling thread.
+  /// @param vector Reference to vector.
+  /// @param left Index of the first element of segment.
+  /// @param right Index of element which follows the last element of segment.
+  static void sort_segment(std::vector<T>& vector, int32_t left, int32_t right);
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Segments_sort_async_task(const Segments_sort_async_task&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Segments_sort_async_task& operator=(const Segments_sort_async_task&);
+
+  /// @brief Function which is executed in separate thread.
+  ///        Should not throw exceptions.
+  virtual void _do_in_background() override;
+
+  /// @brief Function called when error occurred.
+  /// @param error Exception occurred on execution.
+  virtual void _on_error(const std::shared_ptr<std::exception>& error) override;
+
+  // Private fields.
+
+  // Reference to vector which segments should be sorted.
+  std::vector<T>& m_vector;
+
+  // Offsets of segments.
+  const std::vector<int32_t>& m_offsets;
+
+  // Index of the first segment in batch.
+  const int32_t m_first_segment;
+
+  // Index of segment which encloses batch.
+  const int32_t m_last_segment;
+
+  // Segments with this or bigger size are skipped.
+  const int32_t m_large_segment_size;
+
+  // Asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> m_tasks_manager;
+}; // class Segments_sort_async_task
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implementation of the Segments_sort_async_task<T> methods.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+Segments_sort_async_task<T>::Segments_sort_async_task(std::vector<T>& vector, const std::vector<int32_t>& offsets,
+  int32_t first_segment, int32_t last_segment, int32_t large_segment_size,
+  std::shared_ptr<Async_tasks_manager> tasks_manager) :
+    m_vector(vector),
+    m_offsets(offsets),
+    m_first_segment(first_segment),
+    m_last_segment(last_segment),
+    m_large_segment_size(large_segment_size),
+    m_tasks_manager(tasks_manager)
+{
+  assert(first_segment >= 0 && first_segment < last_segment);
+  assert(last_segment < static_cast<int32_t>(offsets.size()));
+  assert(tasks_manager != nullptr);
+}
+
+template<class T>
+Segments_sort_async_task<T>::~Segments_sort_async_task()
+{
+}
+
+template<class T>
+void Segments_sort_async_task<T>::sort_segment(std::vector<T>& vector, int32_t left, int32_t right)
+{
+  assert(left >= 0 && left <= right && right <= static_cast<int32_t>(vector.size()));
+
+  const int32_t size = right - left;
+
+  if (size < 2)
+  {
+    return;
+  }
+
+  if (Sorting_network::is_preferred<T>() && size <= Sorting_network::s_max_size)
+  {
+    Sorting_network::sort(&vector[left], size);
+  }
+  else
+  {
+    std::sort(vector.begin() + left, vector.begin() + right);
+  }
+}
+
+template<class T>
+void Segments_sort_async_task<T>::_do_in_background()
+{
+  bool is_result_ok = true;
+
+  try
+  {
+    for (int32_t segment = m_first_segment; segment < m_last_segment; segment++)
+    {
+      if (m_tasks_manager->is_error_occurred())
+      {
+        break;
+      }
+
+      const int32_t left = m_offsets[segment];
+      const int32_t right = m_offsets[segment + 1];
+
+      if (right - left < m_large_segment_size)
+      {
+        sort_segment(m_vector, left, right); // exception
+      }
+    }
+  }
+  catch (std::exception& error)
+  {
+    std::shared_ptr<std::exception> error_ptr = std::make_shared<std::exception>(error);
+
+    _on_error(error_ptr);
+
+    is_result_ok = false;
+  }
+
+  if (is_result_ok)
+  {
+    m_tasks_manager->handle_task_completion(get_task_id(), nullptr);
+
+    _set_status(Status::completed);
+  }
+}
+
+template<class T>
+void Segments_sort_async_task<T>::_on_error(const std::shared_ptr<std::exception>& error)
+{
+  assert(error != nullptr);
+
+  Async_task::_on_error(error);
+
+  m_tasks_manager->handle_task_completion(get_task_id(), error);
+}
+
+} // My_cpp_libs
+
+#endif // SEGMENTS_SORT_ASYNC_TASK_H_7F3E0A95_D21C_4B68_8E4F_A5C07B19D263
@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file shard_scatter_async_task.h
+/// @brief Interface and implementation of the Shard_chunk struct and the Shard_scatter_async_task<T> class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SHARD_SCATTER_ASYNC_TASK_H_CA53B3BC_FB81_4F30_8F4A_F86C21CD13E2
+#define SHARD_SCATTER_ASYNC_TASK_H_CA53B3BC_FB81_4F30_8F4A_F86C21CD13E2
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct Shard_chunk: chunk of vector which elements are scattered into key ranges of sharded sort by one
+///        task.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Shard_chunk
+{
+  /// @brief Stage of processing of chunk.
+  enum class Stage
+  {
+    count,   // Finds range of every element of chunk and counts elements of chunk in every range.
+    scatter  // Copies every element of chunk into next position of its range.
+  };
+
+  // Public fields.
+
+  // Index of the first element of chunk.
+  int32_t first;
+
+  // Index of element which follows the last element of chunk.
+  int32_t last;
+
+  // Count of elements of chunk in every range (count stage), then next output position of chunk in every range
+  // (scatter stage). Allocated by caller.
+  std::vector<int32_t> range_positions;
+}; // struct Shard_chunk
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Shard_scatter_async_task<T>: asynchronous task which executes one stage of scattering of chunk
+///        of vector into key ranges of sharded sort.
+///
+/// Count stage finds range of every element once (by splitters) and builds histogram of chunk. Output positions
+/// of chunks are prefix sums of histograms (ranges first, chunks second), so scatter stage of every chunk writes
+/// its own slots of output and elements of range keep their order.
+/// @param <T> Type of elements in vector.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+class Shard_scatter_async_task final : public Async_task
+{
+public:
+
+  /// @brief Constructor.
+  /// @param vector Reference to vector which elements are scattered.
+  /// @param splitters Sorted splitters of ranges: element belongs to range of the first splitter greater than it.
+  /// @param element_ranges Range of every element of vector (set by count stage).
+  /// @param output Output of scatter stage (elements of all ranges).
+  /// @param chunk Chunk (range positions are allocated).
+  /// @param stage Stage of processing of chunk.
+  /// @param tasks_manager Asynchronous tasks manager.
+  Shard_scatter_async_task(const std::vector<T>& vector, const std::vector<T>& splitters,
+    std::vector<int32_t>& element_ranges, T* output, Shard_chunk& chunk, Shard_chunk::Stage stage,
+    std::shared_ptr<Async_tasks_manager> tasks_manager);
+
+  /// @brief Destructor.
+  virtual ~Shard_scatter_async_task();
+
+  /// @brief Executes stage in calling thread (used if task can't be started).
+  /// @exception exception Exception thrown by comparison of elements.
+  void execute_stage();
+
+  /// @brief Executes stage of processing of chunk in calling thread.
+  /// @param vector Reference to vector which elements are scattered.
+  /// @param splitters Sorted splitters of ranges.
+  /// @param element_ranges Range of every element of vector (set by count stage).
+  /// @param output Output of scatter stage.
+  /// @param chunk Chunk (range positions are allocated).
+  /// @param stage Stage of processing of chunk.
+  /// @exception exception Exception thrown by comparison of elements.
+  static void execute_stage(const std::vector<T>& vector, const std::vector<T>& splitters,
+    std::vector<int32_t>& element_ranges, T* output, Shard_chunk& chunk, Shard_chunk::Stage stage);
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Shard_scatter_async_task(const Shard_scatter_async_task&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Shard_scatter_async_task& operator=(const Shard_scatter_async_task&);
+
+  /// @brief Function which is executed in separate thread.
+  ///        Should not throw exceptions.
+  virtual void _do_in_background() override;
+
+  /// @brief Function called when error occurred.
+  /// @param error Exception occurred on execution.
+  virtual void _on_error(const std::shared_ptr<std::exception>& error) override;
+
+  // Private fields.
+
+  // Reference to vector which elements are scattered.
+  const std::vector<T>& m_vector;
+
+  // Sorted splitters of ranges.
+  const std::vector<T>& m_splitters;
+
+  // Range of every element of vector.
+  std::vector<int32_t>& m_element_ranges;
+
+  // Output of scatter stage.
+  T* const m_output;
+
+  // Chunk.
+  Shard_chunk& m_chunk;
+
+  // Stage of processing of chunk.
+  const Shard_chunk::Stage m_stage;
+
+  // Asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> m_tasks_manager;
+}; // class Shard_scatter_async_task
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implementation of the Shard_scatter_async_task<T> methods.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+Shard_scatter_async_task<T>::Shard_scatter_async_task(const std::vector<T>& vector, const std::vector<T>& splitters,
+  std::vector<int32_t>& element_ranges, T* output, Shard_chunk& chunk, Shard_chunk::Stage stage,
+  std::shared_ptr<Async_tasks_manager> tasks_manager) :
+    m_vector(vector),
+    m_splitters(splitters),
+    m_element_ranges(element_ranges),
+    m_output(output),
+    m_chunk(chunk),
+    m_stage(stage),
+    m_tasks_manager(tasks_manager)
+{
+  assert(chunk.first >= 0 && chunk.first <= chunk.last && chunk.last <= static_cast<int32_t>(vector.size()));
+  assert(element_ranges.size() == vector.size());
+  assert(chunk.range_positions.size() == splitters.size() + 1);
+  assert(tasks_manager != nullptr);
+}
+
+template<class T>
+Shard_scatter_async_task<T>::~Shard_scatter_async_task()
+{
+}
+
+template<class T>
+void Shard_scatter_async_task<T>::execute_stage()
+{
+  execute_stage(m_vector, m_splitters, m_element_ranges, m_output, m_chunk, m_stage); // exception
+}
+
+template<class T>
+void Shard_scatter_async_task<T>::execute_stage(const std::vector<T>& vector, const std::vector<T>& splitters,
+  std::vector<int32_t>& element_ranges, T* output, Shard_chunk& chunk, Shard_chunk::Stage stage)
+{
+  assert(chunk.first >= 0 && chunk.first <= chunk.last && chunk.last <= static_cast<int32_t>(vector.size()));
+
+  switch (stage)
+  {
+  case Shard_chunk::Stage::count:
+    std::fill(chunk.range_positions.begin(), chunk.range_positions.end(), 0);
+
+    // Element belongs to range of the first splitter greater than it (equal elements are never split).
+    for (int32_t i = chunk.first; i < chunk.last; i++)
+    {
+      const int32_t range = static_cast<int32_t>(std::upper_bound(splitters.begin(), splitters.end(), vector[i]) -
+        splitters.begin()); // exception
+
+      element_ranges[i] = range;
+
+      chunk.range_positions[range]++;
+    }
+    break;
+
+  case Shard_chunk::Stage::scatter:
+    for (int32_t i = chunk.first; i < chunk.last; i++)
+    {
+      output[chunk.range_positions[element_ranges[i]]++] = vector[i];
+    }
+    break;
+  }
+}
+
+template<class T>
+void Shard_scatter_async_task<T>::_do_in_background()
+{
+  bool is_result_ok = true;
+
+  try
+  {
+    execute_stage(); // exception
+  }
+  catch (std::exception& error)
+  {
+    std::shared_ptr<std::exception> error_ptr = std::make_shared<std::exception>(error);
+
+    _on_error(error_ptr);
+
+    is_result_ok = false;
+  }
+
+  if (is_result_ok)
+  {
+    m_tasks_manager->handle_task_completion(get_task_id(), nullptr);
+
+    _set_status(Status::completed);
+  }
+}
+
+template<class T>
+void Shard_scatter_async_task<T>::_on_error(const std::shared_ptr<std::exception>& error)
+{
+  assert(error != nullptr);
+
+  Async_task::_on_error(error);
+
+  m_tasks_manager->handle_task_completion(get_task_id(), error);
+}
+
+} // My_cpp_libs
+
+#endif // SHARD_SCATTER_ASYNC_TASK_H_CA53B3BC_FB81_4F30_8F4A_F86C21CD13E2
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file shared_memory_region.h
+/// @brief Interface of the Shared_memory_region class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SHARED_MEMORY_REGION_H_E5BFFC03_93AC_4F07_8326_CAA32BCF990A
+#define SHARED_MEMORY_REGION_H_E5BFFC03_93AC_4F07_8326_CAA32BCF990A
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Shared_memory_region: POSIX shared memory object (shm_open) mapped into process.
+///
+/// Name of object is removed right after it is mapped, so region is shared only with child processes created
+/// after construction (see Threaded_sort::sharded_sort()) and memory is released when all of them unmap it.
+/// Shared memory is supported on Linux only.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Shared_memory_region final
+{
+public:
+
+  // Public methods.
+
+  /// @brief Constructor: creates and maps shared memory object.
+  /// @param size Size of region in bytes (should be positive).
+  /// @exception invalid_argument Size is zero.
+  /// @exception bad_alloc
+  /// @exception system_error Shared memory object can't be created or mapped (or is not supported).
+  explicit Shared_memory_region(size_t size);
+
+  /// @brief Destructor: unmaps region.
+  ~Shared_memory_region();
+
+  /// @brief Gets memory of region (aligned to page).
+  void* get_data() const;
+
+  /// @brief Gets size of region in bytes.
+  size_t get_size() const;
+
+  /// @brief Checks if shared memory is supported on current platform.
+  static bool is_supported();
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Shared_memory_region(const Shared_memory_region&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Shared_memory_region& operator=(const Shared_memory_region&);
+
+  // Private fields.
+
+  // Memory of region.
+  void* m_data;
+
+  // Size of region in bytes.
+  const size_t m_size;
+}; // class Shared_memory_region
+
+} // My_cpp_libs
+
+#endif // SHARED_MEMORY_REGION_H_E5BFFC03_93AC_4F07_8326_CAA32BCF990A
@@ -1,6 +1,6 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// @file sort_async_task.h
-/// @brief Interface and implementation of the Sort_async_task<T> class.
+/// @brief Interface and implementation of the Sort_async_task<T, Compare> class.
 /// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -11,28 +11,31 @@ namespace My_cpp_libs
 {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// @brief Class Sort_async_task<T>: asynchronous task which implements quick sort algorithm.
-/// @param <T> Type of elements in vector.
-/// ToDo: current version sorts only std::vector<T> in ascending order.
-///       Should be modified to support this prototype:
-///       template<class RandomIt, class Compare>
-///       void sort(RandomIt first, RandomIt last, Compare comp);
+/// @brief Class Sort_async_task<T, Compare>: asynchronous task which implements quick sort algorithm.
+///        Elements are sorted in place: they may be elements of vector or of any other array (e.g. shared memory).
+/// @param <T> Type of elements.
+/// @param <Compare> Function bool(const T& left, const T& right) which checks if left element precedes right one
+///        (strict weak ordering). It is copied for every task and called concurrently.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-template <class T>
+template <class T, class Compare = std::less<>>
 class Sort_async_task final : public Async_task
 {
 public:
 
   /// @brief Constructor.
-  /// @param <T> Type of elements in vector.
-  /// @param vector Reference to vector which should be sorted.
-  /// @param max_recursion_depth Maximum recursion depth (should be positive value).
+  /// @param <T> Type of elements.
+  /// @param elements Pointer to the first element of array which should be sorted.
+  /// @param size Count of elements in array.
   /// @param left Index of element from which sorting range is started.
   /// @param right Index of element which encloses sorting range.
+  /// @param parameters Sort parameters (should be valid).
   /// @param tasks_manager Asynchronous tasks manager.
-  Sort_async_task(std::vector<T>& vector, int32_t left, int32_t right,
-    int32_t max_recursion_depth, std::shared_ptr<Async_tasks_manager> tasks_manager);
+  /// @param placement CPU affinity of sort threads (null: threads are not pinned).
+  /// @param compare Comparison of elements.
+  Sort_async_task(T* elements, int32_t size, int32_t left, int32_t right,
+    const Sort_parameters& parameters, std::shared_ptr<Async_tasks_manager> tasks_manager,
+    std::shared_ptr<const Thread_placement> placement = nullptr, const Compare& compare = Compare());
 
   /// @brief Destructor.
   virtual ~Sort_async_task();
@@ -90,12 +93,25 @@ private:
   /// @exception std::system_error
   void _quick_sort(const int32_t left, const int32_t right);
 
+  /// @brief Implements insertion sort algorithm (used for small ranges which are not sorted by sorting network).
+  /// @param left Index of element from which sorting range is started.
+  /// @param right Index of element which encloses sorting range.
+  void _insertion_sort(const int32_t left, const int32_t right);
+
+  /// @brief Checks if range should be sorted by new asynchronous task.
+  /// @param left Index of element from which sorting range is started.
+  /// @param right Index of element which encloses sorting range.
+  bool _should_start_new_task(const int32_t left, const int32_t right) const;
+
   // Private static constants.
 
   // Private fields.
 
-  // Reference to vector to be sorted.
-  std::vector<T>& m_vector;
+  // Pointer to the first element of array to be sorted.
+  T* const m_elements;
+
+  // Count of elements in array.
+  const int32_t m_size;
 
   // Index of element from which sorting range is started.
   const int32_t m_left;
@@ -103,54 +119,71 @@ private:
   // Index of element which encloses sorting range.
   const int32_t m_right;
 
-  // Maximum depth of recursion.
-  const int32_t m_max_recursion_depth;
+  // Sort parameters.
+  const Sort_parameters m_parameters;
 
   // Asynchronous tasks manager.
   std::shared_ptr<Async_tasks_manager> m_tasks_manager;
 
+  // CPU affinity of sort threads (may be null).
+  std::shared_ptr<const Thread_placement> m_placement;
+
+  // Comparison of elements.
+  Compare m_compare;
+
   // Current level of recursion.
   int32_t m_recursion_level;
 }; // class Sort_async_task
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// Implementation of the Sort_async_task<T> methods.
+/// Implementation of the Sort_async_task<T, Compare> methods.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-template<class T>
-Sort_async_task<T>::Sort_async_task(std::vector<T>& vector, int32_t left, int32_t right,
-  int32_t max_recursion_depth, std::shared_ptr<Async_tasks_manager> tasks_manager) : 
-    m_vector(vector),
+template<class T, class Compare>
+Sort_async_task<T, Compare>::Sort_async_task(T* elements, int32_t size, int32_t left, int32_t right,
+  const Sort_parameters& parameters, std::shared_ptr<Async_tasks_manager> tasks_manager,
+  std::shared_ptr<const Thread_placement> placement, const Compare& compare) : 
+    m_elements(elements),
+    m_size(size),
     m_left(left),
     m_right(right),
-    m_max_recursion_depth(max_recursion_depth),
+    m_parameters(parameters),
     m_tasks_manager(tasks_manager),
+    m_placement(placement),
+    m_compare(compare),
     m_recursion_level(0)
 {
-  assert(left >= 0 && left < static_cast<int32_t>(vector.size()));
-  assert(right >= 0 && right < static_cast<int32_t>(vector.size()));
+  assert(elements != nullptr);
+  assert(left >= 0 && left < size);
+  assert(right >= 0 && right < size);
   assert(left < right);
-  assert(max_recursion_depth >= 0);
+  assert(parameters.is_valid());
   assert(tasks_manager != nullptr);
 }
 
-template<class T>
-Sort_async_task<T>:: ~Sort_async_task()
+template<class T, class Compare>
+Sort_async_task<T, Compare>:: ~Sort_async_task()
 {
 }
 
-template<class T>
-void Sort_async_task<T>::_do_in_background()
+template<class T, class Compare>
+void Sort_async_task<T, Compare>::_do_in_background()
 {
   bool is_result_ok = true;
 
+  // Pin thread to CPUs chosen for memory of sorted range (affinity is not critical: failure is ignored).
+  if (m_placement != nullptr)
+  {
+    m_placement->apply_to_current_thread(&m_elements[m_left]);
+  }
+
   try
   {   
     _quick_sort(m_left, m_right); // exception
   }
   catch (std::exception& error)
   {
-    std::shared_ptr<exception> error_ptr = std::make_shared<std::exception>(error);
+    std::shared_ptr<std::exception> error_ptr = std::make_shared<std::exception>(error);
 
     _on_error(error_ptr);
 
@@ -165,8 +198,8 @@ void Sort_async_task<T>::_do_in_background()
   }  
 }
 
-template<class T>
-void Sort_async_task<T>::_on_error(const std::shared_ptr<std::exception>& error)
+template<class T, class Compare>
+void Sort_async_task<T, Compare>::_on_error(const std::shared_ptr<std::exception>& error)
 {
   assert(error != nullptr);
 
@@ -175,23 +208,23 @@ void Sort_async_task<T>::_on_error(const std::shared_ptr<std::exception>& error)
   m_tasks_manager->handle_task_completion(get_task_id(), error);
 }
 
-template<class T>
-void Sort_async_task<T>::_start_new_sort_async_task(const int32_t left, const int32_t right)
+template<class T, class Compare>
+void Sort_async_task<T, Compare>::_start_new_sort_async_task(const int32_t left, const int32_t right)
 {
-  assert(left >= 0 && left < static_cast<int32_t>(m_vector.size()));
-  assert(right >= 0 && right < static_cast<int32_t>(m_vector.size()));
+  assert(left >= 0 && left < m_size);
+  assert(right >= 0 && right < m_size);
   assert(left < right);
 
-  std::shared_ptr<Async_task> sort_async_task = std::make_shared<Sort_async_task>(m_vector, left, right,
-    m_max_recursion_depth, m_tasks_manager); // exception
+  std::shared_ptr<Async_task> sort_async_task = std::make_shared<Sort_async_task>(m_elements, m_size, left, right,
+    m_parameters, m_tasks_manager, m_placement, m_compare); // exception
 
   m_tasks_manager->add_task(sort_async_task); // exception
 
   sort_async_task->execute(); // exception
 }
 
-template<class T>
-void Sort_async_task<T>::_quick_sort(const int32_t left, const int32_t right)
+template<class T, class Compare>
+void Sort_async_task<T, Compare>::_quick_sort(const int32_t left, const int32_t right)
 { 
   Auto_incrementer recursion_level_incrementer(m_recursion_level);
 
@@ -200,55 +233,118 @@ void Sort_async_task<T>::_quick_sort(const int32_t left, const int32_t right)
     return;
   }
 
-  assert(left >= 0 && left < static_cast<int32_t>(m_vector.size()));
-  assert(right >= 0 && right < static_cast<int32_t>(m_vector.size()));
+  assert(left >= 0 && left < m_size);
+  assert(right >= 0 && right < m_size);
   assert(left < right);
 
-  int32_t i = left;
-  int32_t j = right;
+  if (right - left < m_parameters.insertion_sort_threshold)
+  {
+    // Leaf range: sorting network for branchless types in ascending order, insertion sort for others.
+    if (std::is_same<Compare, std::less<>>::value && Sorting_network::is_preferred<T>() &&
+      right - left < Sorting_network::s_max_size)
+    {
+      Sorting_network::sort(&m_elements[left], right - left + 1);
+    }
+    else
+    {
+      _insertion_sort(left, right);
+    }
+
+    return;
+  }
+
+  // Median of three is moved to the left end: pivot stays in place and is compared by reference,
+  // so elements are never copied (move-only types are supported).
+  const int32_t middle = left + (right - left) / 2;
+
+  if (m_compare(m_elements[middle], m_elements[left])) std::swap(m_elements[middle], m_elements[left]);
+  if (m_compare(m_elements[right], m_elements[middle])) std::swap(m_elements[right], m_elements[middle]);
+  if (m_compare(m_elements[middle], m_elements[left])) std::swap(m_elements[middle], m_elements[left]);
 
-  T comparand = m_vector[(left + right) / 2];
+  std::swap(m_elements[left], m_elements[middle]);
 
-  do
+  const T& pivot = m_elements[left];
+
+  // Hoare partition of (left, right]: scans stop on elements equal to pivot, so duplicates are balanced.
+  int32_t i = left;
+  int32_t j = right + 1;
+
+  while (true)
   {
-    while (m_vector[i] < comparand && i < right) i++;
-    while (comparand < m_vector[j] && j > left) j--;
+    while (m_compare(m_elements[++i], pivot) && i < right);
+    while (m_compare(pivot, m_elements[--j]));
 
-    if (i <= j)
+    if (i >= j)
     {
-      std::swap(m_vector[i], m_vector[j]);
-      i++;
-      j--;
+      break;
     }
-  } while (i <= j);
 
-  assert(j < i);
+    std::swap(m_elements[i], m_elements[j]);
+  }
+
+  // Move pivot to final position: [left, j) <= pivot <= (j, right].
+  std::swap(m_elements[left], m_elements[j]);
 
-  if (left < j)
+  const int32_t left_part_right = j - 1;
+  const int32_t right_part_left = j + 1;
+
+  if (left < left_part_right)
   {
-    if (m_recursion_level <= m_max_recursion_depth)
+    if (!_should_start_new_task(left, left_part_right))
     {
-      _quick_sort(left, j); // exception
+      _quick_sort(left, left_part_right); // exception
     }
     else
     {
-      _start_new_sort_async_task(left, j); // exception
+      _start_new_sort_async_task(left, left_part_right); // exception
     }
   }
 
-  if (i < right)
+  if (right_part_left < right)
   {
-    if (m_recursion_level <= m_max_recursion_depth)
+    if (!_should_start_new_task(right_part_left, right))
     {
-      _quick_sort(i, right); // exception
+      _quick_sort(right_part_left, right); // exception
     }
     else
     {
-      _start_new_sort_async_task(i, right); // exception
+      _start_new_sort_async_task(right_part_left, right); // exception
+    }
+  }
+}
+
+template<class T, class Compare>
+void Sort_async_task<T, Compare>::_insertion_sort(const int32_t left, const int32_t right)
+{
+  assert(left >= 0 && left <= right && right < m_size);
+
+  for (int32_t i = left + 1; i <= right; i++)
+  {
+    if (!m_compare(m_elements[i], m_elements[i - 1]))
+    {
+      continue;
     }
+
+    T element = std::move(m_elements[i]);
+
+    int32_t j = i;
+
+    do
+    {
+      m_elements[j] = std::move(m_elements[j - 1]);
+      j--;
+    } while (j > left && m_compare(element, m_elements[j - 1]));
+
+    m_elements[j] = std::move(element);
   }
 }
 
+template<class T, class Compare>
+bool Sort_async_task<T, Compare>::_should_start_new_task(const int32_t left, const int32_t right) const
+{
+  return (m_recursion_level > m_parameters.max_recursion_depth && right - left + 1 >= m_parameters.min_task_size);
+}
+
 } // My_cpp_libs
 
 #endif // SORT_ASYNC_TASK_H_3B200A24_F0FD_4303_8F55_0DEB50D7A0AA
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file sort_parameters.h
+/// @brief Interface of the Sort_parameters struct.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SORT_PARAMETERS_H_B0A4E5C2_3F61_4C2D_9E8A_71D5F0C3A912
+#define SORT_PARAMETERS_H_B0A4E5C2_3F61_4C2D_9E8A_71D5F0C3A912
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct Sort_parameters: tunable thresholds of threaded quick sort algorithm.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Sort_parameters
+{
+  // Public static constants.
+
+  // Default maximum recursion depth.
+  static const int32_t s_default_max_recursion_depth = 15;
+
+  // Default minimum count of elements in range sorted by new asynchronous task.
+  static const int32_t s_default_min_task_size = 4096;
+
+  // Default maximum count of elements in range sorted by insertion sort.
+  static const int32_t s_default_insertion_sort_threshold = 16;
+
+  // Default maximum count of elements in vector sorted sequentially (without threads).
+  static const int32_t s_default_sequential_sort_threshold = 2048;
+
+  // Default minimum size (in bytes) of elements which are sorted indirectly.
+  static const int32_t s_default_indirect_sort_element_size = 512;
+
+  // Default minimum count of elements in natural run used by adaptive sort.
+  static const int32_t s_default_adaptive_run_length = 64;
+
+  // Public methods.
+
+  /// @brief Constructor: initializes parameters with default values.
+  Sort_parameters() :
+    max_recursion_depth(s_default_max_recursion_depth),
+    min_task_size(s_default_min_task_size),
+    insertion_sort_threshold(s_default_insertion_sort_threshold),
+    sequential_sort_threshold(s_default_sequential_sort_threshold),
+    indirect_sort_element_size(s_default_indirect_sort_element_size),
+    adaptive_run_length(s_default_adaptive_run_length)
+  {
+  }
+
+  /// @brief Checks if all parameters have valid values.
+  bool is_valid() const
+  {
+    return (max_recursion_depth >= 0 && min_task_size >= 2 && insertion_sort_threshold >= 0 &&
+      sequential_sort_threshold >= 0 && indirect_sort_element_size >= 0 && adaptive_run_length >= 0);
+  }
+
+  // Public fields.
+
+  // Maximum recursion depth: deeper ranges are sorted by new asynchronous tasks (should be positive value).
+  int32_t max_recursion_depth;
+
+  // Fork grain: ranges with fewer elements are never sorted by new asynchronous task (should be at least 2).
+  int32_t min_task_size;
+
+  // Leaf cutoff: ranges with no more elements are sorted by insertion sort (0 disables insertion sort).
+  int32_t insertion_sort_threshold;
+
+  // Algorithm selection: vectors with fewer elements are sorted by std::sort in the calling thread.
+  int32_t sequential_sort_threshold;
+
+  // Indirect sort: vectors of elements of this or bigger size (in bytes) are sorted by sorting pointers and
+  // moving every element into final position once (0 disables indirect sort).
+  int32_t indirect_sort_element_size;
+
+  // Adaptive sort: natural runs (not descending or strictly descending) of this or bigger count of elements are
+  // merged if they cover at least half of vector, otherwise vector is sorted by quick sort (0 disables).
+  int32_t adaptive_run_length;
+}; // struct Sort_parameters
+
+} // My_cpp_libs
+
+#endif // SORT_PARAMETERS_H_B0A4E5C2_3F61_4C2D_9E8A_71D5F0C3A912
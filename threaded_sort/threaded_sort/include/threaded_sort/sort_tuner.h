@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file sort_tuner.h
+/// @brief Interface and implementation of the Sort_tuner class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SORT_TUNER_H_E71C9A03_6B4D_4E2F_A8D5_0F3B72C6E194
+#define SORT_TUNER_H_E71C9A03_6B4D_4E2F_A8D5_0F3B72C6E194
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Sort_tuner: calibrates sort parameters on current machine by microbenchmarks.
+///
+/// Parameters are tuned one by one (leaf cutoff, fork grain, recursion depth) by sorting copies of sample,
+/// then the size from which threaded sort outruns sequential std::sort is searched on prefixes of sample.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Sort_tuner
+{
+public:
+
+  // Default count of elements in sample used for calibration.
+  static const int32_t s_default_sample_size = 1 << 18;
+
+  // Count of measurements for every candidate value (the best time is taken).
+  static const int32_t s_measurements_count = 3;
+
+  /// @brief Calibrates sort parameters for element type.
+  /// @param <T> Type of elements in vector.
+  /// @param sample Unsorted sample of typical input data (should contain at least 2 elements).
+  /// @exception invalid_argument Sample is too small.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception
+  template<class T>
+  static Sort_parameters calibrate(const std::vector<T>& sample);
+
+  /// @brief Calibrates sort parameters for element type and stores them in profile.
+  /// @param <T> Type of elements in vector.
+  /// @param sample Unsorted sample of typical input data (should contain at least 2 elements).
+  /// @param profile Tuning profile where parameters are stored.
+  /// @exception invalid_argument Sample is too small.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception
+  template<class T>
+  static void calibrate(const std::vector<T>& sample, Tuning_profile& profile);
+
+private:
+
+  // Private constructor without implementation to prohibit using it.
+  Sort_tuner();
+
+  // Private copy constructor without implementation to prohibit using it.
+  Sort_tuner(const Sort_tuner&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Sort_tuner& operator=(const Sort_tuner&);
+
+  /// @brief Measures the best time (in seconds) of sorting prefix of sample.
+  /// @param sample Unsorted sample.
+  /// @param size Count of elements in prefix of sample.
+  /// @param parameters Sort parameters (used if is_sequential is false).
+  /// @param is_sequential Flag: sort by std::sort instead of threaded sort.
+  template<class T>
+  static double _measure(const std::vector<T>& sample, size_t size, const Sort_parameters& parameters,
+    bool is_sequential);
+
+  /// @brief Selects value of parameter for which sorting of whole sample is the fastest.
+  /// @param sample Unsorted sample.
+  /// @param parameters Sort parameters: selected value is written to them.
+  /// @param parameter Pointer to tuned field of Sort_parameters.
+  /// @param candidates Candidate values of parameter.
+  template<class T>
+  static void _select_parameter(const std::vector<T>& sample, Sort_parameters& parameters,
+    int32_t Sort_parameters::*parameter, const std::vector<int32_t>& candidates);
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implementation of the Sort_tuner methods.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+Sort_parameters Sort_tuner::calibrate(const std::vector<T>& sample)
+{
+  if (sample.size() < 2)
+  {
+    throw std::invalid_argument("sample");
+  }
+
+  const int32_t sample_size = static_cast<int32_t>(sample.size());
+
+  Sort_parameters parameters;
+
+  // Always use threaded sort while its own thresholds are tuned.
+  parameters.sequential_sort_threshold = 0;
+
+  _select_parameter(sample, parameters, &Sort_parameters::insertion_sort_threshold, { 0, 8, 16, 24, 32, 48, 64 });
+
+  std::vector<int32_t> min_task_sizes;
+
+  for (int64_t min_task_size = 256; min_task_size <= std::max(sample_size / 4, 256); min_task_size *= 4)
+  {
+    min_task_sizes.push_back(static_cast<int32_t>(min_task_size));
+  }
+
+  _select_parameter(sample, parameters, &Sort_parameters::min_task_size, min_task_sizes);
+
+  _select_parameter(sample, parameters, &Sort_parameters::max_recursion_depth, { 0, 1, 2, 4, 8, 15 });
+
+  // Search the smallest size from which threaded sort is faster than std::sort.
+  parameters.sequential_sort_threshold = std::numeric_limits<int32_t>::max();
+
+  for (size_t size = 256; size <= sample.size(); size *= 4)
+  {
+    const double threaded_time = _measure(sample, size, parameters, false);
+    const double sequential_time = _measure(sample, size, parameters, true);
+
+    if (threaded_time < sequential_time)
+    {
+      parameters.sequential_sort_threshold = static_cast<int32_t>(size);
+      break;
+    }
+  }
+
+  assert(parameters.is_valid());
+
+  return parameters;
+}
+
+template<class T>
+void Sort_tuner::calibrate(const std::vector<T>& sample, Tuning_profile& profile)
+{
+  Sort_parameters parameters = calibrate(sample); // exception
+
+  profile.set_parameters(typeid(T).name(), static_cast<int32_t>(sizeof(T)), parameters); // exception
+}
+
+template<class T>
+double Sort_tuner::_measure(const std::vector<T>& sample, size_t size, const Sort_parameters& parameters,
+  bool is_sequential)
+{
+  assert(size >= 2 && size <= sample.size());
+
+  double best_time = std::numeric_limits<double>::max();
+
+  for (int32_t i = 0; i < s_measurements_count; i++)
+  {
+    std::vector<T> work_vector(sample.begin(), sample.begin() + size); // exception
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    if (is_sequential)
+    {
+      std::sort(work_vector.begin(), work_vector.end());
+    }
+    else
+    {
+      Threaded_sort::quick_sort(work_vector, parameters); // exception
+    }
+
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start_time;
+
+    best_time = std::min(best_time, time.count());
+  }
+
+  return best_time;
+}
+
+template<class T>
+void Sort_tuner::_select_parameter(const std::vector<T>& sample, Sort_parameters& parameters,
+  int32_t Sort_parameters::*parameter, const std::vector<int32_t>& candidates)
+{
+  assert(!candidates.empty());
+
+  Sort_parameters candidate_parameters = parameters;
+
+  double best_time = std::numeric_limits<double>::max();
+
+  for (int32_t candidate : candidates)
+  {
+    candidate_parameters.*parameter = candidate;
+
+    assert(candidate_parameters.is_valid());
+
+    const double time = _measure(sample, sample.size(), candidate_parameters, false); // exception
+
+    if (time < best_time)
+    {
+      best_time = time;
+      parameters.*parameter = candidate;
+    }
+  }
+}
+
+} // My_cpp_libs
+
+#endif // SORT_TUNER_H_E71C9A03_6B4D_4E2F_A8D5_0F3B72C6E194
@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file sort_workspace.h
+/// @brief Interface of the Sort_workspace class, interface and implementation of the Workspace_allocator<T> class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SORT_WORKSPACE_H_6245861C_0805_4965_ABAF_6ADC9932315F
+#define SORT_WORKSPACE_H_6245861C_0805_4965_ABAF_6ADC9932315F
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Sort_workspace: scratch memory owned by caller and reused by sorts (see
+///        Threaded_sort::get_workspace_size()).
+///
+/// Workspace is one aligned block of memory (optionally backed by huge pages on Linux) from which buffers of sort
+/// are allocated sequentially. Buffers are released all together when sort returns, so once workspace is large
+/// enough sorts don't allocate scratch memory. Workspace should be used by one sort at a time.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Sort_workspace final
+{
+public:
+
+  // Nested classes.
+
+  /// @brief Class Scope: releases buffers allocated from workspace after its construction when it is destroyed.
+  class Scope final
+  {
+  public:
+
+    /// @brief Constructor.
+    /// @param workspace Workspace (may be null).
+    explicit Scope(Sort_workspace* workspace) :
+      m_workspace(workspace),
+      m_used_size((workspace != nullptr) ? workspace->get_used_size() : 0)
+    {
+    }
+
+    /// @brief Destructor.
+    ~Scope()
+    {
+      if (m_workspace != nullptr)
+      {
+        m_workspace->_release(m_used_size);
+      }
+    }
+
+  private:
+
+    // Private copy constructor without implementation to prohibit using it.
+    Scope(const Scope&);
+
+    // Private assignment operator without implementation to prohibit using it.
+    Scope& operator=(const Scope&);
+
+    // Workspace.
+    Sort_workspace* const m_workspace;
+
+    // Used size of workspace on construction.
+    const size_t m_used_size;
+  }; // class Scope
+
+  // Public constants.
+
+  // Default alignment of memory block and buffers (cache line).
+  static const size_t s_default_alignment = 64;
+
+  // Public methods.
+
+  /// @brief Constructor.
+  /// @param capacity Size of memory block in bytes (0: block is allocated by the first sort).
+  /// @param alignment Alignment of memory block and buffers (power of two).
+  /// @param is_huge_pages_used Flag: memory block is backed by huge pages if possible (Linux only, otherwise
+  ///        ignored): explicit huge pages are tried first (alignment up to 2 MB), then transparent huge pages are
+  ///        advised (alignment up to page size).
+  /// @exception std::invalid_argument Alignment is not power of two.
+  /// @exception std::bad_alloc
+  explicit Sort_workspace(size_t capacity = 0, size_t alignment = s_default_alignment,
+    bool is_huge_pages_used = false);
+
+  /// @brief Destructor.
+  ~Sort_workspace();
+
+  /// @brief Grows memory block to given capacity (only if no buffers are allocated, otherwise does nothing).
+  /// @param capacity Size of memory block in bytes.
+  /// @exception std::bad_alloc Workspace is not changed.
+  void reserve(size_t capacity);
+
+  /// @brief Gets size of memory block in bytes.
+  size_t get_capacity() const;
+
+  /// @brief Gets size of allocated buffers in bytes (including padding for alignment).
+  size_t get_used_size() const;
+
+  /// @brief Gets alignment of memory block and buffers.
+  size_t get_alignment() const;
+
+  /// @brief Checks if huge pages were requested for memory block.
+  bool is_huge_pages_used() const;
+
+  /// @brief Gets count of memory blocks allocated from system (stays the same while sorts fit into workspace).
+  int32_t get_blocks_count() const;
+
+  /// @brief Allocates buffer from memory block.
+  /// @param size Size of buffer in bytes.
+  /// @param alignment Alignment of buffer (power of two, at least alignment of workspace is used).
+  /// @return Buffer or null if there is not enough free memory in block.
+  void* allocate(size_t size, size_t alignment);
+
+  /// @brief Checks if memory belongs to memory block.
+  /// @param pointer Pointer to memory.
+  bool is_owner(const void* pointer) const;
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Sort_workspace(const Sort_workspace&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Sort_workspace& operator=(const Sort_workspace&);
+
+  /// @brief Releases buffers allocated after given used size.
+  /// @param used_size Used size of workspace.
+  void _release(size_t used_size);
+
+  /// @brief Frees memory block.
+  void _free_block();
+
+  // Private fields.
+
+  // Memory block.
+  char* m_block;
+
+  // Size of memory block in bytes.
+  size_t m_capacity;
+
+  // Size of allocated buffers in bytes.
+  size_t m_used_size;
+
+  // Alignment of memory block and buffers.
+  const size_t m_alignment;
+
+  // Flag: huge pages are requested for memory block.
+  const bool m_is_huge_pages_used;
+
+  // Flag: memory block is mapped by mmap (otherwise allocated by operator new).
+  bool m_is_block_mapped;
+
+  // Count of memory blocks allocated from system.
+  int32_t m_blocks_count;
+}; // class Sort_workspace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Workspace_allocator<T>: allocator of scratch buffers of sort. Buffers are allocated from workspace
+///        if it is set and has enough free memory (they are released by Sort_workspace::Scope), otherwise from heap.
+/// @param <T> Type of elements.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+class Workspace_allocator
+{
+public:
+
+  // Public types.
+
+  typedef T value_type;
+
+  // Public methods.
+
+  /// @brief Constructor.
+  /// @param workspace Workspace (null: buffers are allocated from heap).
+  Workspace_allocator(Sort_workspace* workspace = nullptr) noexcept : m_workspace(workspace)
+  {
+  }
+
+  /// @brief Constructor of allocator of other type with the same workspace.
+  template<class U>
+  Workspace_allocator(const Workspace_allocator<U>& other) noexcept : m_workspace(other.get_workspace())
+  {
+  }
+
+  /// @brief Allocates memory for count elements.
+  /// @exception std::bad_alloc
+  T* allocate(size_t count)
+  {
+    if (m_workspace != nullptr && count <= std::numeric_limits<size_t>::max() / sizeof(T))
+    {
+      void* buffer = m_workspace->allocate(count * sizeof(T), alignof(T));
+
+      if (buffer != nullptr)
+      {
+        return static_cast<T*>(buffer);
+      }
+    }
+
+    return std::allocator<T>().allocate(count); // exception
+  }
+
+  /// @brief Deallocates memory (memory of workspace is released by Sort_workspace::Scope).
+  void deallocate(T* pointer, size_t count) noexcept
+  {
+    if (m_workspace == nullptr || !m_workspace->is_owner(pointer))
+    {
+      std::allocator<T>().deallocate(pointer, count);
+    }
+  }
+
+  /// @brief Gets workspace.
+  Sort_workspace* get_workspace() const noexcept
+  {
+    return m_workspace;
+  }
+
+private:
+
+  // Private fields.
+
+  // Workspace (may be null).
+  Sort_workspace* m_workspace;
+}; // class Workspace_allocator
+
+template<class T, class U>
+inline bool operator==(const Workspace_allocator<T>& left, const Workspace_allocator<U>& right) noexcept
+{
+  return (left.get_workspace() == right.get_workspace());
+}
+
+template<class T, class U>
+inline bool operator!=(const Workspace_allocator<T>& left, const Workspace_allocator<U>& right) noexcept
+{
+  return (left.get_workspace() != right.get_workspace());
+}
+
+// Vector of scratch buffer of sort.
+template<class T>
+using Workspace_vector = std::vector<T, Workspace_allocator<T>>;
+
+} // My_cpp_libs
+
+#endif // SORT_WORKSPACE_H_6245861C_0805_4965_ABAF_6ADC9932315F
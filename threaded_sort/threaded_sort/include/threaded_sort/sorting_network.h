@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file sorting_network.h
+/// @brief Interface and implementation of the Sorting_network class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SORTING_NETWORK_H_2C7E91B4_58DA_4F03_A6C9_E1B04F7D3826
+#define SORTING_NETWORK_H_2C7E91B4_58DA_4F03_A6C9_E1B04F7D3826
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Sorting_network: sorts small ranges of fixed size (up to s_max_size) by sorting networks.
+///
+/// Networks (Batcher's odd-even merge sort) are generated at compile time and fully unrolled, so for
+/// arithmetic types every comparator is a branchless min/max pair which compilers vectorize.
+/// Other types are compared by operator< and swapped.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Sorting_network
+{
+public:
+
+  // Maximum count of elements sorted by sorting network.
+  static const int32_t s_max_size = 32;
+
+  /// @brief Sorts N elements in ascending order.
+  /// @param <N> Count of elements (should not be greater than s_max_size).
+  /// @param <T> Type of elements.
+  /// @param elements Pointer to the first element.
+  template<size_t N, class T>
+  static void sort_fixed(T* elements);
+
+  /// @brief Sorts array in ascending order.
+  /// @param <N> Count of elements (should not be greater than s_max_size).
+  /// @param <T> Type of elements.
+  /// @param elements Array of elements.
+  template<size_t N, class T>
+  static void sort_fixed(std::array<T, N>& elements);
+
+  /// @brief Sorts elements in ascending order by sorting network chosen at runtime.
+  /// @param <T> Type of elements.
+  /// @param elements Pointer to the first element.
+  /// @param count Count of elements (should not be greater than s_max_size).
+  template<class T>
+  static void sort(T* elements, size_t count);
+
+  /// @brief Checks if sorting networks are preferred over insertion sort for element type:
+  ///        true for types compared without branches (arithmetic types and pointers).
+  template<class T>
+  static constexpr bool is_preferred();
+
+  /// @brief Gets count of comparators in network sorting N elements.
+  template<size_t N>
+  static constexpr size_t get_comparators_count();
+
+private:
+
+  // Nested structs.
+
+  /// @brief Comparator of network: exchanges elements if elements[high] < elements[low].
+  struct Comparator
+  {
+    uint8_t low;
+    uint8_t high;
+  };
+
+  /// @brief Comparators of network sorting N elements (generated at compile time).
+  template<size_t N>
+  struct Network;
+
+  // Private methods.
+
+  // Private constructor without implementation to prohibit using it.
+  Sorting_network();
+
+  // Private copy constructor without implementation to prohibit using it.
+  Sorting_network(const Sorting_network&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Sorting_network& operator=(const Sorting_network&);
+
+  /// @brief Calls visitor for every comparator (low, high) of Batcher's odd-even merge sort network.
+  ///        Network is built for the nearest power of 2 and comparators of missing elements are skipped
+  ///        (missing elements can be treated as greatest ones, so these comparators never exchange).
+  template<class Visitor>
+  static constexpr void _for_each_comparator(size_t size, Visitor& visitor);
+
+  /// @brief Counts comparators of network sorting given count of elements.
+  static constexpr size_t _count_comparators(size_t size);
+
+  /// @brief Generates comparators of network sorting given count of elements.
+  template<size_t Count>
+  static constexpr std::array<Comparator, Count> _generate_comparators(size_t size);
+
+  /// @brief Exchanges elements if second one is less than first one.
+  template<class T>
+  static void _compare_exchange(T& first, T& second);
+
+  /// @brief Applies all comparators of network (unrolled at compile time).
+  template<size_t N, class T, size_t... I>
+  static void _apply(T* elements, std::index_sequence<I...>);
+
+  /// @brief Gets table of sort_fixed<N, T> functions for N in [0, s_max_size].
+  template<class T, size_t... N>
+  static constexpr std::array<void (*)(T*), sizeof...(N)> _make_sort_table(std::index_sequence<N...>);
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implementation of the Sorting_network methods.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<size_t N>
+struct Sorting_network::Network
+{
+  static constexpr size_t s_comparators_count = _count_comparators(N);
+
+  static constexpr std::array<Comparator, s_comparators_count> s_comparators =
+    _generate_comparators<s_comparators_count>(N);
+};
+
+template<class Visitor>
+constexpr void Sorting_network::_for_each_comparator(size_t size, Visitor& visitor)
+{
+  size_t padded_size = 1;
+
+  while (padded_size < size)
+  {
+    padded_size <<= 1;
+  }
+
+  for (size_t p = 1; p < padded_size; p <<= 1)
+  {
+    for (size_t k = p; k >= 1; k >>= 1)
+    {
+      for (size_t j = k % p; j + k < padded_size; j += 2 * k)
+      {
+        for (size_t i = 0; i < k && i + j + k < padded_size; i++)
+        {
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < size)
+          {
+            visitor(i + j, i + j + k);
+          }
+        }
+      }
+    }
+  }
+}
+
+constexpr size_t Sorting_network::_count_comparators(size_t size)
+{
+  size_t count = 0;
+
+  auto counter = [&count](size_t, size_t) { count++; };
+
+  _for_each_comparator(size, counter);
+
+  return count;
+}
+
+template<size_t Count>
+constexpr std::array<Sorting_network::Comparator, Count> Sorting_network::_generate_comparators(size_t size)
+{
+  std::array<Comparator, Count> comparators = {};
+
+  size_t index = 0;
+
+  auto generator = [&comparators, &index](size_t low, size_t high)
+  {
+    comparators[index].low = static_cast<uint8_t>(low);
+    comparators[index].high = static_cast<uint8_t>(high);
+    index++;
+  };
+
+  _for_each_comparator(size, generator);
+
+  return comparators;
+}
+
+template<class T>
+inline void Sorting_network::_compare_exchange(T& first, T& second)
+{
+  if constexpr (is_preferred<T>())
+  {
+    // Branchless: compiled to min/max (cmov or SIMD) instructions.
+    const T low = (second < first) ? second : first;
+    const T high = (second < first) ? first : second;
+
+    first = low;
+    second = high;
+  }
+  else
+  {
+    if (second < first)
+    {
+      std::swap(first, second);
+    }
+  }
+}
+
+template<size_t N, class T, size_t... I>
+inline void Sorting_network::_apply([[maybe_unused]] T* elements, std::index_sequence<I...>)
+{
+  // Networks of 0 and 1 elements have no comparators: elements are not used.
+  (_compare_exchange(elements[Network<N>::s_comparators[I].low], elements[Network<N>::s_comparators[I].high]),
+    ...);
+}
+
+template<size_t N, class T>
+void Sorting_network::sort_fixed(T* elements)
+{
+  static_assert(N <= static_cast<size_t>(s_max_size), "Sorting network is too big.");
+
+  assert(elements != nullptr || N == 0);
+
+  _apply<N>(elements, std::make_index_sequence<Network<N>::s_comparators_count>());
+}
+
+template<size_t N, class T>
+void Sorting_network::sort_fixed(std::array<T, N>& elements)
+{
+  sort_fixed<N>(elements.data());
+}
+
+template<class T, size_t... N>
+constexpr std::array<void (*)(T*), sizeof...(N)> Sorting_network::_make_sort_table(std::index_sequence<N...>)
+{
+  return {{ static_cast<void (*)(T*)>(&Sorting_network::sort_fixed<N, T>)... }};
+}
+
+template<class T>
+void Sorting_network::sort(T* elements, size_t count)
+{
+  static constexpr std::array<void (*)(T*), s_max_size + 1> sort_table =
+    _make_sort_table<T>(std::make_index_sequence<s_max_size + 1>());
+
+  assert(count <= static_cast<size_t>(s_max_size));
+
+  sort_table[count](elements);
+}
+
+template<class T>
+constexpr bool Sorting_network::is_preferred()
+{
+  return std::is_arithmetic<T>::value || std::is_pointer<T>::value;
+}
+
+template<size_t N>
+constexpr size_t Sorting_network::get_comparators_count()
+{
+  return Network<N>::s_comparators_count;
+}
+
+} // My_cpp_libs
+
+#endif // SORTING_NETWORK_H_2C7E91B4_58DA_4F03_A6C9_E1B04F7D3826
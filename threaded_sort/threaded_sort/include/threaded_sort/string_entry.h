@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file string_entry.h
+/// @brief Interface and implementation of the String_entry struct.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STRING_ENTRY_H_70FFFDB0_40D7_463C_A3DA_621D5F4C4271
+#define STRING_ENTRY_H_70FFFDB0_40D7_463C_A3DA_621D5F4C4271
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct String_entry: string sorted by String_sort_async_task with cached key bytes.
+///
+/// Cache holds s_cache_size characters of string starting from current depth (characters before depth are
+/// equal in all strings of sorted range) as big-endian number padded by zeros, so comparison of caches is
+/// comparison of characters as unsigned char (like std::char_traits<char>::compare).
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct String_entry
+{
+  // Public static constants.
+
+  // Count of characters in cache.
+  static constexpr size_t s_cache_size = sizeof(uint64_t);
+
+  // Public methods.
+
+  /// @brief Loads cache with characters starting from depth.
+  /// @param depth Count of characters which are skipped (should not be greater than length).
+  void load_cache(size_t depth)
+  {
+    assert(depth <= length);
+
+    const size_t count = std::min(length - depth, s_cache_size);
+
+    // Characters are copied to zero padded buffer: compilers merge shifts below into one byte swap.
+    unsigned char bytes[s_cache_size] = {};
+
+    std::memcpy(bytes, characters + depth, count);
+
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < s_cache_size; i++)
+    {
+      value = (value << 8) | bytes[i];
+    }
+
+    cache = value;
+  }
+
+  /// @brief Checks if all characters of string (starting from depth) are in cache.
+  /// @param depth Count of characters which are skipped.
+  bool is_finished(size_t depth) const
+  {
+    return (length <= depth + s_cache_size);
+  }
+
+  // Public fields.
+
+  // Characters starting from current depth (big-endian, padded by zeros).
+  uint64_t cache;
+
+  // Characters of string.
+  const char* characters;
+
+  // Length of string.
+  size_t length;
+
+  // Index of string in sorted vector.
+  int32_t index;
+}; // struct String_entry
+
+} // My_cpp_libs
+
+#endif // STRING_ENTRY_H_70FFFDB0_40D7_463C_A3DA_621D5F4C4271
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file string_sort_async_task.h
+/// @brief Interface of the String_sort_async_task class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STRING_SORT_ASYNC_TASK_H_E3B03236_2061_4376_9191_280CD0ED5D9D
+#define STRING_SORT_ASYNC_TASK_H_E3B03236_2061_4376_9191_280CD0ED5D9D
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class String_sort_async_task: asynchronous task which implements multikey quick sort of strings
+///        with cached key characters (see String_entry).
+///
+/// Range is partitioned in three parts by cache of pivot (no strings are copied or dereferenced):
+/// less, equal and greater. Less and greater parts are sorted at the same depth, strings of equal part
+/// share s_cache_size more characters, so this part is sorted at the next depth (prefix is never rescanned).
+/// Less and greater parts are sorted by new asynchronous tasks as in Sort_async_task<T>.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class String_sort_async_task final : public Async_task
+{
+public:
+
+  /// @brief Constructor.
+  /// @param entries Reference to vector of string entries which should be sorted.
+  /// @param left Index of entry from which sorting range is started.
+  /// @param right Index of entry which follows the last entry of sorting range.
+  /// @param depth Count of characters which are equal in all strings of range (caches are loaded from depth).
+  /// @param parameters Sort parameters (should be valid).
+  /// @param tasks_manager Asynchronous tasks manager.
+  String_sort_async_task(Workspace_vector<String_entry>& entries, int32_t left, int32_t right, size_t depth,
+    const Sort_parameters& parameters, std::shared_ptr<Async_tasks_manager> tasks_manager);
+
+  /// @brief Destructor.
+  virtual ~String_sort_async_task();
+
+private:
+
+  // Nested classes.
+
+  /// @brief Class which increments passed by reference variable in constructor and decrements in destructor.
+  class Auto_incrementer final
+  {
+  public:
+
+    Auto_incrementer(int32_t& counter) : m_counter(counter)
+    {
+      counter++;
+    }
+
+    ~Auto_incrementer()
+    {
+      m_counter--;
+    }
+
+  private:
+
+    int32_t& m_counter;
+  }; // class Auto_incrementer
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  String_sort_async_task(const String_sort_async_task&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  String_sort_async_task& operator=(const String_sort_async_task&);
+
+  /// @brief Function which is executed in separate thread.
+  ///        Should not throw exceptions.
+  virtual void _do_in_background() override;
+
+  /// @brief Function called when error occurred.
+  /// @param error Exception occurred on execution.
+  virtual void _on_error(const std::shared_ptr<std::exception>& error) override;
+
+  /// @brief Starts new asynchronous task which sorts range at given depth.
+  /// @exception std::bad_alloc
+  void _start_new_sort_async_task(int32_t left, int32_t right, size_t depth);
+
+  /// @brief Sorts range [left, right) or starts new task for it.
+  /// @exception std::bad_alloc
+  /// @exception std::system_error
+  void _sort_or_start_new_task(int32_t left, int32_t right, size_t depth);
+
+  /// @brief Implements multikey quick sort algorithm.
+  /// @param left Index of entry from which sorting range is started.
+  /// @param right Index of entry which follows the last entry of sorting range.
+  /// @param depth Count of characters which are equal in all strings of range.
+  /// @exception std::bad_alloc
+  /// @exception std::system_error
+  void _multikey_quick_sort(int32_t left, int32_t right, size_t depth);
+
+  /// @brief Implements insertion sort algorithm (used for small ranges): caches are compared first,
+  ///        rest of strings only if caches are equal.
+  void _insertion_sort(int32_t left, int32_t right, size_t depth);
+
+  /// @brief Checks if range should be sorted by new asynchronous task.
+  bool _should_start_new_task(int32_t left, int32_t right) const;
+
+  // Private fields.
+
+  // Reference to vector of string entries to be sorted.
+  Workspace_vector<String_entry>& m_entries;
+
+  // Index of entry from which sorting range is started.
+  const int32_t m_left;
+
+  // Index of entry which follows the last entry of sorting range.
+  const int32_t m_right;
+
+  // Count of characters which are equal in all strings of range.
+  const size_t m_depth;
+
+  // Sort parameters.
+  const Sort_parameters m_parameters;
+
+  // Asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> m_tasks_manager;
+
+  // Current level of recursion.
+  int32_t m_recursion_level;
+}; // class String_sort_async_task
+
+} // My_cpp_libs
+
+#endif // STRING_SORT_ASYNC_TASK_H_E3B03236_2061_4376_9191_280CD0ED5D9D
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file thread_placement.h
+/// @brief Interface of the Thread_placement class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THREAD_PLACEMENT_H_9A6D2F17_C84B_4E3A_B5F1_27E0D93C6A48
+#define THREAD_PLACEMENT_H_9A6D2F17_C84B_4E3A_B5F1_27E0D93C6A48
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Thread_placement: CPU affinity of sort threads (Linux only, on other platforms it does nothing).
+///
+/// Threads are pinned to the given CPU set. If placement is NUMA aware then thread sorting some range is pinned
+/// to CPUs (from the set) of the NUMA node which owns memory of the range, so subranges stay on the node which
+/// first touched them. If NUMA topology is not available all CPUs are considered to be on single node.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Thread_placement final
+{
+public:
+
+  /// @brief Constructor: NUMA aware placement on all CPUs available to process.
+  /// @exception std::bad_alloc
+  Thread_placement();
+
+  /// @brief Constructor.
+  /// @param cpus CPUs to which threads are pinned (should be not empty and available to process).
+  /// @param is_numa_aware Flag: pin threads to CPUs of NUMA node which owns memory of sorted range.
+  /// @exception std::invalid_argument Invalid CPU set.
+  /// @exception std::bad_alloc
+  Thread_placement(const std::vector<int32_t>& cpus, bool is_numa_aware);
+
+  /// @brief Destructor.
+  ~Thread_placement();
+
+  /// @brief Gets CPUs available to process (independently of affinity of calling thread).
+  /// @exception std::bad_alloc
+  static std::vector<int32_t> get_available_cpus();
+
+  /// @brief Gets CPUs to which threads are pinned.
+  const std::vector<int32_t>& get_cpus() const;
+
+  /// @brief Checks if placement is NUMA aware.
+  bool is_numa_aware() const;
+
+  /// @brief Gets count of NUMA nodes (1 if NUMA topology is not available).
+  int32_t get_numa_nodes_count() const;
+
+  /// @brief Gets CPUs of NUMA node which belong to placement CPU set.
+  /// @param node NUMA node (should be in range [0, get_numa_nodes_count())).
+  const std::vector<int32_t>& get_node_cpus(int32_t node) const;
+
+  /// @brief Gets NUMA node which owns memory page with given address (0 if it can't be determined).
+  /// @param address Address of memory.
+  int32_t get_memory_node(const void* address) const;
+
+  /// @brief Pins calling thread (pthread_setaffinity_np) to CPUs chosen for memory with given address.
+  /// @param address Address of memory which is processed by thread.
+  /// @return True if affinity is set.
+  bool apply_to_current_thread(const void* address) const;
+
+private:
+
+  // Private methods.
+
+  // Private copy constructor without implementation to prohibit using it.
+  Thread_placement(const Thread_placement&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Thread_placement& operator=(const Thread_placement&);
+
+  /// @brief Initializes CPUs of NUMA nodes (intersected with placement CPU set).
+  /// @exception std::bad_alloc
+  void _init_node_cpus();
+
+  /// @brief Parses list of CPUs or nodes in kernel format ("0-3,8,10-11").
+  /// @exception std::bad_alloc
+  static std::vector<int32_t> _parse_list(const std::string& list);
+
+  // Private fields.
+
+  // CPUs to which threads are pinned (sorted).
+  std::vector<int32_t> m_cpus;
+
+  // Flag: pin threads to CPUs of NUMA node which owns memory of sorted range.
+  bool m_is_numa_aware;
+
+  // CPUs of NUMA nodes which belong to m_cpus (index is node).
+  std::vector<std::vector<int32_t>> m_node_cpus;
+}; // class Thread_placement
+
+} // My_cpp_libs
+
+#endif // THREAD_PLACEMENT_H_9A6D2F17_C84B_4E3A_B5F1_27E0D93C6A48
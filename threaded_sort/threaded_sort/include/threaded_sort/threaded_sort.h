@@ -23,7 +23,20 @@ class Threaded_sort
 public:
 
   // Default maximum recursion depth.
-  static const int32_t s_default_max_recursion_depth = 15;
+  static const int32_t s_default_max_recursion_depth = Sort_parameters::s_default_max_recursion_depth;
+
+  // Environment variable with path to tuning profile which is loaded on the first sort.
+  static const char* const s_tuning_profile_environment_variable;
+
+  /// @brief Implements threaded quick sort algorithm with parameters tuned for element type
+  ///        (see set_tuning_profile()).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which should be sorted.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void quick_sort(std::vector<T>& input_vector);
 
   /// @brief Implements threaded quick sort algorithm.
   /// @param <T> Type of elements in vector.
@@ -34,10 +47,502 @@ public:
   /// @exception system_error
   /// @exception exception 
   template<class T>
-  static void quick_sort(std::vector<T>& input_vector, int32_t max_recursion_depth = s_default_max_recursion_depth);
+  static void quick_sort(std::vector<T>& input_vector, int32_t max_recursion_depth);
+
+  /// @brief Implements threaded quick sort algorithm.
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param parameters Sort parameters (should be valid).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters);
+
+  /// @brief Implements threaded quick sort algorithm with sort threads pinned to CPUs.
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param placement CPU affinity of sort threads (null: threads are not pinned).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+    const std::shared_ptr<const Thread_placement>& placement);
+
+  /// @brief Implements threaded quick sort algorithm with scratch buffers (merge buffer of adaptive sort, buffers
+  ///        of indirect sort and string sort) allocated from workspace: workspace is grown once to
+  ///        get_workspace_size() bytes (if it is not used by other sort), then sorts of vectors of the same size
+  ///        don't allocate scratch buffers.
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param workspace Workspace owned by caller (should not be used by other sort at the same time).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters, Sort_workspace& workspace);
+
+  /// @brief Implements threaded quick sort algorithm with sort threads pinned to CPUs and scratch buffers
+  ///        allocated from workspace (see above).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param placement CPU affinity of sort threads (null: threads are not pinned).
+  /// @param workspace Workspace owned by caller (should not be used by other sort at the same time).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+    const std::shared_ptr<const Thread_placement>& placement, Sort_workspace& workspace);
+
+  /// @brief Sorts strings by parallel multikey quick sort with cached key characters: strings are not copied,
+  ///        common prefixes are not rescanned (see String_sort_async_task). Then strings are moved into final
+  ///        position once. Parameters are tuned for element type (see set_tuning_profile()).
+  ///        Threaded quick sort of std::string and std::string_view uses this algorithm.
+  /// @param <T> Type of elements in vector: std::string or std::string_view (e.g. views of one arena).
+  /// @param vector Reference to vector which should be sorted.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void string_sort(std::vector<T>& input_vector);
+
+  /// @brief Sorts strings by parallel multikey quick sort with cached key characters.
+  /// @param <T> Type of elements in vector: std::string or std::string_view.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param parameters Sort parameters (should be valid).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void string_sort(std::vector<T>& input_vector, const Sort_parameters& parameters);
+
+  /// @brief Sorts strings by parallel multikey quick sort with scratch buffers allocated from workspace
+  ///        (see quick_sort()).
+  /// @param <T> Type of elements in vector: std::string or std::string_view.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param workspace Workspace owned by caller (should not be used by other sort at the same time).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void string_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+    Sort_workspace& workspace);
+
+  /// @brief Sorts independent segments of vector in one scheduling pass: small segments are packed into batches
+  ///        of balanced cost (one per worker thread), large segments are sorted by threaded quick sort.
+  ///        Parameters are tuned for element type (see set_tuning_profile()).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which segments should be sorted.
+  /// @param offsets Offsets of segments: segment i is [offsets[i], offsets[i + 1]), offsets.front() is 0,
+  ///        offsets.back() is size of vector, offsets are not decreasing.
+  /// @exception invalid_argument Invalid offsets.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void segmented_sort(std::vector<T>& input_vector, const std::vector<int32_t>& offsets);
+
+  /// @brief Sorts independent segments of vector in one scheduling pass.
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which segments should be sorted.
+  /// @param offsets Offsets of segments (see above).
+  /// @param parameters Sort parameters (should be valid): segments smaller than both min_task_size and
+  ///        sequential_sort_threshold are sorted in batches.
+  /// @exception invalid_argument Invalid offsets or sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void segmented_sort(std::vector<T>& input_vector, const std::vector<int32_t>& offsets,
+    const Sort_parameters& parameters);
+
+  /// @brief Merges sorted vectors into output vector (stable: equal elements are ordered by index of input).
+  ///        Output is split into equal pieces (one per worker thread) by co-ranks of their boundaries in inputs,
+  ///        every piece is merged independently by loser tree (see Multiway_merge_async_task<Iterator>).
+  ///        Parameters are tuned for element type (see set_tuning_profile()).
+  /// @param <T> Type of elements (should be default constructible and copy assignable).
+  /// @param inputs Sorted vectors.
+  /// @param output Output vector (resized to total count of elements, should not be one of inputs).
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void multiway_merge(const std::vector<std::vector<T>>& inputs, std::vector<T>& output);
+
+  /// @brief Merges sorted vectors into output vector.
+  /// @param <T> Type of elements (should be default constructible and copy assignable).
+  /// @param inputs Sorted vectors.
+  /// @param output Output vector (resized to total count of elements, should not be one of inputs).
+  /// @param parameters Sort parameters (should be valid): pieces are not smaller than min_task_size,
+  ///        less than sequential_sort_threshold elements are merged in calling thread.
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void multiway_merge(const std::vector<std::vector<T>>& inputs, std::vector<T>& output,
+    const Sort_parameters& parameters);
+
+  /// @brief Merges sorted ranges given by pairs of iterators into output vector (see above).
+  /// @param <Iterator> Random access iterator.
+  /// @param ranges Sorted ranges: [first, second).
+  /// @param output Output vector (resized to total count of elements, should not intersect ranges).
+  /// @exception invalid_argument Invalid range.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class Iterator>
+  static void multiway_merge(const std::vector<std::pair<Iterator, Iterator>>& ranges,
+    std::vector<typename std::iterator_traits<Iterator>::value_type>& output);
+
+  /// @brief Merges sorted ranges given by pairs of iterators into output vector (see above).
+  /// @param <Iterator> Random access iterator.
+  /// @param ranges Sorted ranges: [first, second).
+  /// @param output Output vector (resized to total count of elements, should not intersect ranges).
+  /// @param parameters Sort parameters (should be valid).
+  /// @exception invalid_argument Invalid range or sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class Iterator>
+  static void multiway_merge(const std::vector<std::pair<Iterator, Iterator>>& ranges,
+    std::vector<typename std::iterator_traits<Iterator>::value_type>& output, const Sort_parameters& parameters);
+
+  /// @brief Merges new batch of elements into sorted vector: only batch is sorted (by threaded quick sort), then
+  ///        it is merged into vector in place by pieces in parallel (see Batch_merge_async_task<T>). Extra memory
+  ///        is bounded by batch: at most batch size elements are saved for every worker thread.
+  ///        Equal elements of vector precede elements of batch. Parameters are tuned for element type
+  ///        (see set_tuning_profile()).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to sorted vector.
+  /// @param batch New elements (moved into vector, batch is cleared).
+  /// @exception invalid_argument Batch is vector.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void merge_batch(std::vector<T>& sorted_vector, std::vector<T>& batch);
+
+  /// @brief Merges new batch of elements into sorted vector.
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to sorted vector.
+  /// @param batch New elements (moved into vector, batch is cleared).
+  /// @param parameters Sort parameters (should be valid): pieces of merge are not smaller than min_task_size,
+  ///        less than sequential_sort_threshold elements are merged in calling thread.
+  /// @exception invalid_argument Batch is vector or invalid sort parameters.
+  /// @exception bad_alloc Vector is not changed.
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void merge_batch(std::vector<T>& sorted_vector, std::vector<T>& batch, const Sort_parameters& parameters);
+
+  /// @brief Merges new batch of elements into sorted vector with scratch buffers (of batch sort and saved elements)
+  ///        allocated from workspace: workspace is grown to size of the largest buffer (if it is not used by other
+  ///        sort), then merges of batches of the same size don't allocate scratch buffers.
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to sorted vector.
+  /// @param batch New elements (moved into vector, batch is cleared).
+  /// @param parameters Sort parameters (should be valid).
+  /// @param workspace Workspace owned by caller (should not be used by other sort at the same time).
+  /// @exception invalid_argument Batch is vector or invalid sort parameters.
+  /// @exception bad_alloc Vector is not changed.
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void merge_batch(std::vector<T>& sorted_vector, std::vector<T>& batch, const Sort_parameters& parameters,
+    Sort_workspace& workspace);
+
+  /// @brief Sorts vector by threaded quick sort and removes consecutive equal elements (like std::unique after sort,
+  ///        but without extra single-threaded pass): see sort_reduce_by_key(). Which one of equal elements is kept
+  ///        is not specified. Parameters are tuned for element type (see set_tuning_profile()).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector.
+  /// @return Count of unique elements: they are compacted at start of vector, other elements are moved from
+  ///         (vector is not resized).
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static int32_t sort_unique(std::vector<T>& input_vector);
+
+  /// @brief Sorts vector by threaded quick sort and removes consecutive equal elements.
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector.
+  /// @param parameters Sort parameters (should be valid).
+  /// @return Count of unique elements compacted at start of vector.
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static int32_t sort_unique(std::vector<T>& input_vector, const Sort_parameters& parameters);
+
+  /// @brief Sorts vector by threaded quick sort and removes consecutive equal elements with scratch buffers
+  ///        allocated from workspace (see sort_reduce_by_key()).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param workspace Workspace owned by caller (should not be used by other sort at the same time).
+  /// @return Count of unique elements compacted at start of vector.
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static int32_t sort_unique(std::vector<T>& input_vector, const Sort_parameters& parameters,
+    Sort_workspace& workspace);
+
+  /// @brief Sorts vector by threaded quick sort and reduces every group of equal elements (by operator<, e.g. equal
+  ///        keys) into one element. Sorted vector is split into chunks at group starts (one per worker thread),
+  ///        groups are reduced by chunks in parallel right after sort and results are compacted in parallel
+  ///        (see Reduce_async_task<T, Reduce>). Parameters are tuned for element type (see set_tuning_profile()).
+  /// @param <T> Type of elements in vector.
+  /// @param <Reduce> Function void(T& result, const T& element) which adds element into result of group.
+  ///        It is copied for every task and called concurrently for different groups, elements of group are
+  ///        added in unspecified order. It should not change order of result.
+  /// @param vector Reference to vector.
+  /// @param reduce Reduce function.
+  /// @return Count of groups: their results are compacted at start of vector, other elements are moved from
+  ///         (vector is not resized).
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T, class Reduce>
+  static int32_t sort_reduce_by_key(std::vector<T>& input_vector, Reduce reduce);
+
+  /// @brief Sorts vector by threaded quick sort and reduces every group of equal elements into one element.
+  /// @param <T> Type of elements in vector.
+  /// @param <Reduce> Function void(T& result, const T& element) which adds element into result of group.
+  /// @param vector Reference to vector.
+  /// @param reduce Reduce function.
+  /// @param parameters Sort parameters (should be valid): chunks are not smaller than min_task_size,
+  ///        less than sequential_sort_threshold elements are reduced in calling thread.
+  /// @return Count of groups compacted at start of vector.
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T, class Reduce>
+  static int32_t sort_reduce_by_key(std::vector<T>& input_vector, Reduce reduce, const Sort_parameters& parameters);
+
+  /// @brief Sorts vector by threaded quick sort and reduces every group of equal elements into one element with
+  ///        scratch buffers (of sort and saved results) allocated from workspace: workspace is grown to size of
+  ///        the largest buffer (if it is not used by other sort), then reductions of vectors of the same size
+  ///        don't allocate scratch buffers.
+  /// @param <T> Type of elements in vector.
+  /// @param <Reduce> Function void(T& result, const T& element) which adds element into result of group.
+  /// @param vector Reference to vector.
+  /// @param reduce Reduce function.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param workspace Workspace owned by caller (should not be used by other sort at the same time).
+  /// @return Count of groups compacted at start of vector.
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T, class Reduce>
+  static int32_t sort_reduce_by_key(std::vector<T>& input_vector, Reduce reduce, const Sort_parameters& parameters,
+    Sort_workspace& workspace);
+
+  /// @brief Sorts vector by keys derived from elements (e.g. parsed field): key of every element is computed exactly
+  ///        once (by chunks in parallel, see Key_extract_async_task<T, Key, Projection>) and cached in key entry
+  ///        with index of element, entries are sorted by threaded quick sort, then every element is moved into final
+  ///        position once. Sort is stable. Parameters are tuned for key entries (see set_tuning_profile()).
+  /// @param <T> Type of elements in vector.
+  /// @param <Projection> Function Key(const T& element) or pointer to member of T. It is copied for every task
+  ///        and called concurrently for different elements. Key should be default constructible and comparable by
+  ///        operator<.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param projection Projection.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception
+  template<class T, class Projection>
+  static void sort_by_key(std::vector<T>& input_vector, Projection projection);
+
+  /// @brief Sorts vector by keys derived from elements with keys computed once.
+  /// @param <T> Type of elements in vector.
+  /// @param <Projection> Function Key(const T& element) or pointer to member of T.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param projection Projection.
+  /// @param parameters Sort parameters (should be valid): chunks of keys are not smaller than min_task_size,
+  ///        keys of less than sequential_sort_threshold elements are computed in calling thread.
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc Vector is not changed (unless elements may throw on move).
+  /// @exception system_error
+  /// @exception exception Exception thrown by projection or comparison of keys: vector is not changed.
+  template<class T, class Projection>
+  static void sort_by_key(std::vector<T>& input_vector, Projection projection, const Sort_parameters& parameters);
+
+  /// @brief Sorts vector by keys derived from elements in order given by comparison of keys (e.g. descending order
+  ///        by std::greater<>), keys are computed once. Sort is stable. Parameters are tuned for key entries.
+  /// @param <T> Type of elements in vector.
+  /// @param <Projection> Function Key(const T& element) or pointer to member of T.
+  /// @param <Compare> Function bool(const Key& left, const Key& right) which checks if left key precedes right one
+  ///        (strict weak ordering). It is copied for every task and called concurrently.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param projection Projection.
+  /// @param compare Comparison of keys.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception
+  template<class T, class Projection, class Compare>
+  static void sort_by_key(std::vector<T>& input_vector, Projection projection, Compare compare);
+
+  /// @brief Sorts vector by keys derived from elements in order given by comparison of keys.
+  /// @param <T> Type of elements in vector.
+  /// @param <Projection> Function Key(const T& element) or pointer to member of T.
+  /// @param <Compare> Function bool(const Key& left, const Key& right) which checks if left key precedes right one.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param projection Projection.
+  /// @param compare Comparison of keys (std::less<> for other overloads): keys are sorted by generic quick sort
+  ///        for std::less<>, by threaded quick sort with given comparison for others.
+  /// @param parameters Sort parameters (should be valid).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc Vector is not changed (unless elements may throw on move).
+  /// @exception system_error
+  /// @exception exception Exception thrown by projection or comparison of keys: vector is not changed.
+  template<class T, class Projection, class Compare>
+  static void sort_by_key(std::vector<T>& input_vector, Projection projection, Compare compare,
+    const Sort_parameters& parameters);
+
+  /// @brief Sorts vector by keys derived from elements with key entries, order of elements and scratch buffers
+  ///        of permutation allocated from workspace: workspace is grown to size of all buffers (if it is not used
+  ///        by other sort), then sorts of vectors of the same size don't allocate scratch buffers.
+  /// @param <T> Type of elements in vector.
+  /// @param <Projection> Function Key(const T& element) or pointer to member of T.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param projection Projection.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param workspace Workspace owned by caller (should not be used by other sort at the same time).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc Vector is not changed (unless elements may throw on move).
+  /// @exception system_error
+  /// @exception exception Exception thrown by projection or comparison of keys: vector is not changed.
+  template<class T, class Projection>
+  static void sort_by_key(std::vector<T>& input_vector, Projection projection, const Sort_parameters& parameters,
+    Sort_workspace& workspace);
+
+  /// @brief Sorts vector by keys derived from elements in order given by comparison of keys with buffers
+  ///        allocated from workspace.
+  /// @param <T> Type of elements in vector.
+  /// @param <Projection> Function Key(const T& element) or pointer to member of T.
+  /// @param <Compare> Function bool(const Key& left, const Key& right) which checks if left key precedes right one.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param projection Projection.
+  /// @param compare Comparison of keys.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param workspace Workspace owned by caller (should not be used by other sort at the same time).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc Vector is not changed (unless elements may throw on move).
+  /// @exception system_error
+  /// @exception exception Exception thrown by projection or comparison of keys: vector is not changed.
+  template<class T, class Projection, class Compare>
+  static void sort_by_key(std::vector<T>& input_vector, Projection projection, Compare compare,
+    const Sort_parameters& parameters, Sort_workspace& workspace);
+
+  /// @brief Sorts vector by several local processes (more than one process is used on Linux only): sampled splitters
+  ///        split elements into key ranges (one per process), calling process scatters every element once to its
+  ///        range in shared memory (see Shared_memory_region) by chunks in parallel, every range is sorted in place
+  ///        by threaded quick sort of its own worker process (the first range is sorted by calling process), then
+  ///        sorted elements are copied into vector. Worker processes are created by fork(), so elements are never
+  ///        passed through pipes or sockets. Threads of scattering are joined before fork(), but other threads of
+  ///        calling process may run: worker process is a copy of multithreaded process which creates its own tasks
+  ///        manager and sort threads. It relies on glibc, which keeps malloc() and pthread_create() usable in child
+  ///        after fork() (arenas are locked around fork()); besides them, worker process touches only its range of
+  ///        shared memory and library-private state inherited from calling process and never locks mutex of tuning
+  ///        profile. Comparison of elements should not take locks which may be held by other threads of calling
+  ///        process (they are never released in worker process).
+  ///        Parameters are tuned for element type (see set_tuning_profile()).
+  /// @param <T> Type of elements in vector (should be trivially copyable: elements are shared as bytes).
+  /// @param vector Reference to vector which should be sorted.
+  /// @param processes_count Maximum count of processes sorting ranges (including calling process).
+  /// @exception invalid_argument processes_count is not positive.
+  /// @exception bad_alloc
+  /// @exception system_error Worker process or shared memory can't be created.
+  /// @exception runtime_error Worker process failed: vector is not changed.
+  /// @exception exception
+  template<class T>
+  static void sharded_sort(std::vector<T>& input_vector, int32_t processes_count);
+
+  /// @brief Sorts vector by several local processes.
+  /// @param <T> Type of elements in vector (should be trivially copyable).
+  /// @param vector Reference to vector which should be sorted.
+  /// @param processes_count Maximum count of processes sorting ranges (including calling process).
+  /// @param parameters Sort parameters (should be valid): ranges are not smaller than min_task_size on average,
+  ///        vectors with less than sequential_sort_threshold elements are sorted in calling process.
+  /// @exception invalid_argument processes_count is not positive or invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error Worker process or shared memory can't be created.
+  /// @exception runtime_error Worker process failed: vector is not changed.
+  /// @exception exception
+  template<class T>
+  static void sharded_sort(std::vector<T>& input_vector, int32_t processes_count, const Sort_parameters& parameters);
+
+  /// @brief Checks if vector of elements is sorted indirectly: pointers to elements are sorted by threaded quick sort
+  ///        and then every element is moved into final position once (in parallel).
+  ///        Used for nothrow movable elements not smaller than parameters.indirect_sort_element_size.
+  /// @param <T> Type of elements in vector.
+  /// @param parameters Sort parameters.
+  template<class T>
+  static bool is_indirect_sort_used(const Sort_parameters& parameters);
+
+  /// @brief Gets size of workspace in bytes which is enough for scratch buffers of quick sort (and string sort) of
+  ///        vector (memory of asynchronous tasks is not included).
+  /// @param <T> Type of elements in vector.
+  /// @param size Count of elements in vector.
+  /// @param parameters Sort parameters.
+  /// @param alignment Alignment of workspace.
+  template<class T>
+  static size_t get_workspace_size(int32_t size, const Sort_parameters& parameters,
+    size_t alignment = Sort_workspace::s_default_alignment);
+
+  /// @brief Gets sort parameters tuned for element type.
+  /// @param <T> Type of elements in vector.
+  template<class T>
+  static Sort_parameters get_tuned_parameters();
+
+  /// @brief Sets count of worker threads which share work split into chunks (scan of runs, merges, reductions,
+  ///        extraction of keys, permutation). Threads of quick sort are limited by sort parameters.
+  /// @param workers_count Count of worker threads (0: count of hardware threads, by default).
+  /// @exception invalid_argument Count is negative.
+  static void set_workers_count(int32_t workers_count);
+
+  /// @brief Gets count of worker threads which share work split into chunks (at least 1).
+  static int32_t get_workers_count();
+
+  /// @brief Sets tuning profile used by sorts without explicit parameters.
+  /// @param profile Tuning profile.
+  /// @exception bad_alloc
+  static void set_tuning_profile(const Tuning_profile& profile);
+
+  /// @brief Gets tuning profile used by sorts without explicit parameters.
+  ///        On the first call profile is loaded from file named by environment variable
+  ///        THREADED_SORT_TUNING_PROFILE (if it can't be loaded default parameters are used).
+  /// @exception bad_alloc
+  static Tuning_profile get_tuning_profile();
 
 private:
 
+  // Private constants.
+
+  // Count of samples per key range used to choose splitters of sharded sort.
+  static const int32_t s_sharded_sort_samples_per_range = 64;
+
+  // Private methods.
+
   // Private constructor without implementation to prohibit using it.
   Threaded_sort();
 
@@ -46,45 +551,2029 @@ private:
 
   // Private assignment operator without implementation to prohibit using it.
   Threaded_sort& operator=(const Threaded_sort&);
-};
 
-template<class T>
-void Threaded_sort::quick_sort(std::vector<T>& input_vector, int32_t max_recursion_depth)
-{
-  if (max_recursion_depth < 0)
-  {
-    throw invalid_argument("max_recursion_depth");
-  }
+  /// @brief Waits for completion of all tasks and throws error occurred on execution (if any).
+  /// @param tasks_manager Asynchronous tasks manager.
+  /// @exception system_error
+  /// @exception exception 
+  static void _wait_for_all_tasks_completion(const std::shared_ptr<Async_tasks_manager>& tasks_manager);
 
-  if (input_vector.size() < 2)
-  {
-    return;
-  }
+  /// @brief Gets count of chunks of work: one per worker thread, chunks are not smaller than min_task_size.
+  ///        Less than sequential_sort_threshold elements are processed in one chunk.
+  /// @param size Count of elements.
+  /// @param parameters Sort parameters (should be valid).
+  static int32_t _get_chunks_count(int64_t size, const Sort_parameters& parameters);
 
-  // Create asynchronous tasks manager.
-  shared_ptr<Async_tasks_manager> tasks_manager = make_shared<Async_tasks_manager>(); // exception
+  /// @brief Processes chunks of work: the first chunk is processed in calling thread, others by asynchronous tasks
+  ///        (or in calling thread if task can't be created). Waits for completion of tasks and throws error of the
+  ///        first failed task.
+  /// @param <Process_chunk> Function void(int32_t chunk) which processes chunk in calling thread.
+  /// @param <Create_task> Function std::shared_ptr<Task>(int32_t chunk, const std::shared_ptr<Async_tasks_manager>&)
+  ///        which creates task processing chunk (Task is derived from Async_task).
+  /// @param chunks_count Count of chunks (at least 1).
+  /// @param process_chunk Function which processes chunk in calling thread.
+  /// @param create_task Function which creates task.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception Exception thrown by processing of chunk.
+  template<class Process_chunk, class Create_task>
+  static void _run_chunks(int32_t chunks_count, Process_chunk process_chunk, Create_task create_task);
 
-  // Create top level quick sort asynchronous task.
-  shared_ptr<Sort_async_task<T>> sort_async_task = make_shared<Sort_async_task<T>>(input_vector, 0,
-    input_vector.size() - 1, max_recursion_depth, tasks_manager); // exception
+  /// @brief Processes chunks of work (see above), failed tasks are handled after completion of all tasks.
+  /// @param <Handle_failed_task> Function void(Task& task) which handles task which failed to start or on execution
+  ///        (e.g. processes its chunk in calling thread or throws its error).
+  /// @param chunks_count Count of chunks (at least 1).
+  /// @param process_chunk Function which processes chunk in calling thread.
+  /// @param create_task Function which creates task.
+  /// @param handle_failed_task Function which handles failed task.
+  /// @exception system_error
+  /// @exception exception Exception thrown by processing of chunk or by handling of failed task.
+  template<class Process_chunk, class Create_task, class Handle_failed_task>
+  static void _run_chunks(int32_t chunks_count, Process_chunk process_chunk, Create_task create_task,
+    Handle_failed_task handle_failed_task);
 
-  // Add task to tasks manager.
-  tasks_manager->add_task(sort_async_task);
+  /// @brief Implements threaded quick sort algorithm (see quick_sort()).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param placement CPU affinity of sort threads (null: threads are not pinned).
+  /// @param workspace Workspace of scratch buffers (null: buffers are allocated from heap).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void _quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+    const std::shared_ptr<const Thread_placement>& placement, Sort_workspace* workspace);
 
-  // Execute sort synchronous task.
-  sort_async_task->execute();
+  /// @brief Sorts array in place by asynchronous quick sort tasks (without selection of specialized algorithm).
+  /// @param <T> Type of elements.
+  /// @param elements Pointer to the first element of array (e.g. of vector or of shared memory).
+  /// @param size Count of elements (at least 2).
+  /// @param parameters Sort parameters (should be valid).
+  /// @param placement CPU affinity of sort threads (null: threads are not pinned).
+  /// @param compare Comparison of elements (see Sort_async_task<T, Compare>).
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T, class Compare = std::less<>>
+  static void _sort_by_tasks(T* elements, int32_t size, const Sort_parameters& parameters,
+    const std::shared_ptr<const Thread_placement>& placement, const Compare& compare = Compare());
 
-  // Wait while all asynchronous sort tasks are completed.
-  tasks_manager->wait_for_all_tasks_completion();
+  /// @brief Sorts strings by parallel multikey quick sort (see string_sort()).
+  /// @param <T> Type of elements in vector: std::string or std::string_view.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param workspace Workspace of scratch buffers (null: buffers are allocated from heap).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void _string_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+    Sort_workspace* workspace);
+
+  /// @brief Merges new batch of elements into sorted vector (see merge_batch()).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to sorted vector.
+  /// @param batch New elements (moved into vector, batch is cleared).
+  /// @param parameters Sort parameters (should be valid).
+  /// @param workspace Workspace of scratch buffers (null: buffers are allocated from heap).
+  /// @exception invalid_argument Batch is vector or invalid sort parameters.
+  /// @exception bad_alloc Vector is not changed.
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void _merge_batch(std::vector<T>& sorted_vector, std::vector<T>& batch, const Sort_parameters& parameters,
+    Sort_workspace* workspace);
+
+  /// @brief Sorts vector and reduces every group of equal elements into one element (see sort_reduce_by_key()).
+  /// @param <T> Type of elements in vector.
+  /// @param <Reduce> Function void(T& result, const T& element) which adds element into result of group.
+  /// @param vector Reference to vector.
+  /// @param reduce Reduce function.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param workspace Workspace of scratch buffers (null: buffers are allocated from heap).
+  /// @return Count of groups compacted at start of vector.
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T, class Reduce>
+  static int32_t _sort_reduce_by_key(std::vector<T>& input_vector, Reduce reduce, const Sort_parameters& parameters,
+    Sort_workspace* workspace);
 
-  // Get execution error.
-  shared_ptr<exception> execution_error = tasks_manager->get_error();
+  /// @brief Implements sort by cached keys (see sort_by_key()).
+  /// @param <T> Type of elements in vector.
+  /// @param <Projection> Function Key(const T& element) or pointer to member of T.
+  /// @param <Compare> Function bool(const Key& left, const Key& right) which checks if left key precedes right one.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param projection Projection.
+  /// @param compare Comparison of keys.
+  /// @param parameters Sort parameters.
+  /// @param workspace Workspace of scratch buffers (null: buffers are allocated from heap).
+  /// @exception invalid_argument Invalid sort parameters.
+  /// @exception bad_alloc Vector is not changed (unless elements may throw on move).
+  /// @exception system_error
+  /// @exception exception Exception thrown by projection or comparison of keys: vector is not changed.
+  template<class T, class Projection, class Compare>
+  static void _sort_by_key(std::vector<T>& input_vector, Projection& projection, const Compare& compare,
+    const Sort_parameters& parameters, Sort_workspace* workspace);
 
-  // Throw error if it occurred on execution.
-  if (execution_error != nullptr)
-  {
-    throw exception(*execution_error);
-  }
+  /// @brief Computes key entries of all elements (by chunks in parallel), sorts them and saves order of elements.
+  ///        Entries of heap are sorted by generic quick sort for std::less<>, other entries are sorted by threaded
+  ///        quick sort with given comparison.
+  /// @param <T> Type of elements in vector.
+  /// @param <Projection> Function Key(const T& element) or pointer to member of T.
+  /// @param <Compare> Function bool(const Key& left, const Key& right) which checks if left key precedes right one.
+  /// @param <Key> Type of key.
+  /// @param <Entry_allocator> Allocator of key entries.
+  /// @param vector Reference to vector.
+  /// @param projection Projection.
+  /// @param compare Comparison of keys.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param entries Key entries (size is size of vector).
+  /// @param sources Output: index of element which should be moved to every position (size is size of vector).
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception Exception thrown by projection or comparison of keys.
+  template<class T, class Projection, class Compare, class Key, class Entry_allocator>
+  static void _sort_key_entries(const std::vector<T>& input_vector, Projection& projection, const Compare& compare,
+    const Sort_parameters& parameters, std::vector<Key_entry<Key>, Entry_allocator>& entries,
+    Workspace_vector<int32_t>& sources);
+
+  /// @brief Gets size of workspace in bytes used by sort by cached keys (see sort_by_key()).
+  /// @param <T> Type of elements in vector.
+  /// @param <Key> Type of key.
+  /// @param size Count of elements in vector.
+  /// @param parameters Sort parameters.
+  /// @param alignment Alignment of workspace.
+  template<class T, class Key>
+  static size_t _get_sort_by_key_workspace_size(int32_t size, const Sort_parameters& parameters, size_t alignment);
+
+  /// @brief Gets size of workspace in bytes used by _permute() (see get_workspace_size()).
+  /// @param <T> Type of elements in vector.
+  /// @param size Count of elements in vector.
+  /// @param parameters Sort parameters.
+  /// @param alignment Alignment of workspace.
+  template<class T>
+  static size_t _get_permute_workspace_size(int32_t size, const Sort_parameters& parameters, size_t alignment);
+
+  /// @brief Sorts vector with long natural runs: runs are found by parallel scan, descending runs are reversed
+  ///        in place, ranges between runs are sorted, then all ranges are merged in order of powersort
+  ///        (merges of one level of merge tree are executed in parallel).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param parameters Sort parameters (should be valid, adaptive_run_length should be positive).
+  /// @param placement CPU affinity of sort threads (null: threads are not pinned).
+  /// @param workspace Workspace of merge buffer (null: buffer is allocated from heap).
+  /// @return False if natural runs cover less than half of vector: vector is not changed.
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception
+  template<class T>
+  static bool _adaptive_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+    const std::shared_ptr<const Thread_placement>& placement, Sort_workspace* workspace);
+
+  /// @brief Executes independent jobs of adaptive sort in batches of balanced size (one per worker thread).
+  ///        Doesn't wait for completion of tasks.
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which is sorted.
+  /// @param jobs Jobs (should not be changed until tasks are completed).
+  /// @param merge_buffer Merge buffer of vector.size() / 2 elements (null: merges use std::inplace_merge).
+  /// @param tasks_manager Asynchronous tasks manager.
+  /// @exception bad_alloc
+  template<class T>
+  static void _start_run_merge_jobs(std::vector<T>& input_vector, const std::vector<Run_merge_job>& jobs,
+    T* merge_buffer, const std::shared_ptr<Async_tasks_manager>& tasks_manager);
+
+  /// @brief Plans merges of sorted ranges by powersort policy: merge tree is built from powers of boundaries
+  ///        between ranges (nearly balanced for any lengths of ranges).
+  /// @param range_starts Index of the first element of every range and size of vector (at least 2 ranges).
+  /// @param levels Output: merges of every level of merge tree (merges of one level are independent).
+  /// @exception bad_alloc
+  static void _plan_run_merges(const std::vector<int32_t>& range_starts,
+    std::vector<std::vector<Run_merge_job>>& levels);
+
+  /// @brief Gets power of boundary between two neighbouring ranges: depth of the top level of binary partition
+  ///        of vector which splits middles of ranges.
+  /// @param first Index of the first element of the left range.
+  /// @param left_size Count of elements in the left range.
+  /// @param right_size Count of elements in the right range.
+  /// @param size Count of elements in vector.
+  static int32_t _get_merge_power(int64_t first, int64_t left_size, int64_t right_size, int64_t size);
+
+  /// @brief Sorts vector of large elements indirectly (see is_indirect_sort_used()).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which should be sorted.
+  /// @param parameters Sort parameters (should be valid).
+  /// @param placement CPU affinity of sort threads (null: threads are not pinned).
+  /// @param workspace Workspace of scratch buffers (null: buffers are allocated from heap).
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception exception 
+  template<class T>
+  static void _indirect_quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+    const std::shared_ptr<const Thread_placement>& placement, Sort_workspace* workspace);
+
+  /// @brief Moves elements of vector into final position after indirect sort: cycles of permutation are followed
+  ///        in place by chunks in parallel (see Permute_async_task<T>).
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which is permuted.
+  /// @param sources Index of element which should be moved to every position (destroyed on return). Scratch
+  ///        buffers are allocated by its allocator.
+  /// @param parameters Sort parameters: chunks are not smaller than min_task_size.
+  /// @exception bad_alloc Vector is not changed.
+  /// @exception system_error
+  template<class T>
+  static void _permute(std::vector<T>& input_vector, Workspace_vector<int32_t>& sources,
+    const Sort_parameters& parameters);
+
+  /// @brief Executes stage of reduction for all chunks (see _run_chunks()): chunks of tasks which failed to start
+  ///        save or restore stage are processed in calling thread.
+  /// @param <T> Type of elements in vector.
+  /// @param <Reduce> Reduce function.
+  /// @param vector Reference to sorted vector.
+  /// @param chunks Chunks of vector.
+  /// @param reduce Reduce function.
+  /// @param saved_elements Saved results of all chunks (used by save and restore stages).
+  /// @param stage Stage of reduction.
+  /// @exception bad_alloc Only on reduce stage.
+  /// @exception system_error
+  /// @exception exception Exception thrown by comparison or reduction of elements.
+  template<class T, class Reduce>
+  static void _execute_reduce_stage(std::vector<T>& input_vector, std::vector<Reduce_chunk>& chunks, Reduce& reduce,
+    T* saved_elements, Reduce_chunk::Stage stage);
+
+  /// @brief Executes stage of scattering for all chunks (see _run_chunks()): chunks of tasks which failed to start
+  ///        scatter stage are processed in calling thread.
+  /// @param <T> Type of elements in vector.
+  /// @param vector Reference to vector which elements are scattered.
+  /// @param splitters Sorted splitters of ranges.
+  /// @param element_ranges Range of every element of vector (set by count stage).
+  /// @param output Output of scatter stage.
+  /// @param chunks Chunks of vector.
+  /// @param stage Stage of scattering.
+  /// @exception system_error
+  /// @exception exception Exception thrown by comparison of elements.
+  template<class T>
+  static void _execute_shard_stage(const std::vector<T>& input_vector, const std::vector<T>& splitters,
+    std::vector<int32_t>& element_ranges, T* output, std::vector<Shard_chunk>& chunks, Shard_chunk::Stage stage);
+
+  /// @brief Sorts vector by worker processes (see sharded_sort()).
+  /// @param <T> Type of elements in vector (should be trivially copyable).
+  /// @param vector Reference to vector which should be sorted.
+  /// @param ranges_count Count of key ranges (at least 2, not greater than size of vector).
+  /// @param parameters Sort parameters (should be valid).
+  /// @exception bad_alloc
+  /// @exception system_error
+  /// @exception runtime_error Worker process failed: vector is not changed.
+  /// @exception exception
+  template<class T>
+  static void _sharded_sort(std::vector<T>& input_vector, int32_t ranges_count, const Sort_parameters& parameters);
+
+  /// @brief Starts worker process (by fork()) which executes work and exits: exit status is 0 if work doesn't throw.
+  /// @param work Work executed by worker process.
+  /// @return Identifier of worker process.
+  /// @exception system_error Process can't be created.
+  static int32_t _start_worker_process(const std::function<void()>& work);
+
+  /// @brief Waits for completion of worker processes.
+  /// @param process_ids Identifiers of worker processes.
+  /// @return True if all processes exited with status 0.
+  static bool _wait_for_worker_processes(const std::vector<int32_t>& process_ids);
+
+  /// @brief Loads tuning profile from file named by environment variable (only on the first call).
+  ///        Should be called with locked s_tuning_profile_mutex.
+  static void _load_tuning_profile_once();
+
+  // Private static fields.
+
+  // Mutex used to synchronize access to tuning profile.
+  static std::mutex s_tuning_profile_mutex;
+
+  // Tuning profile used by sorts without explicit parameters.
+  static Tuning_profile s_tuning_profile;
+
+  // Flag: tuning profile was loaded from environment or set explicitly.
+  static bool s_is_tuning_profile_loaded;
+
+  // Count of worker threads set explicitly (0: count of hardware threads).
+  static std::atomic<int32_t> s_workers_count;
+};
+
+template<class T>
+void Threaded_sort::quick_sort(std::vector<T>& input_vector)
+{
+  quick_sort(input_vector, get_tuned_parameters<T>()); // exception
+}
+
+template<class T>
+void Threaded_sort::quick_sort(std::vector<T>& input_vector, int32_t max_recursion_depth)
+{
+  if (max_recursion_depth < 0)
+  {
+    throw std::invalid_argument("max_recursion_depth");
+  }
+
+  Sort_parameters parameters = get_tuned_parameters<T>(); // exception
+
+  parameters.max_recursion_depth = max_recursion_depth;
+
+  quick_sort(input_vector, parameters); // exception
+}
+
+template<class T>
+void Threaded_sort::quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters)
+{
+  quick_sort(input_vector, parameters, nullptr); // exception
+}
+
+template<class T>
+void Threaded_sort::quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+  const std::shared_ptr<const Thread_placement>& placement)
+{
+  _quick_sort(input_vector, parameters, placement, nullptr); // exception
+}
+
+template<class T>
+void Threaded_sort::quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+  Sort_workspace& workspace)
+{
+  quick_sort(input_vector, parameters, nullptr, workspace); // exception
+}
+
+template<class T>
+void Threaded_sort::quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+  const std::shared_ptr<const Thread_placement>& placement, Sort_workspace& workspace)
+{
+  workspace.reserve(get_workspace_size<T>(static_cast<int32_t>(input_vector.size()), parameters,
+    workspace.get_alignment())); // exception
+
+  _quick_sort(input_vector, parameters, placement, &workspace); // exception
+}
+
+template<class T>
+void Threaded_sort::_quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+  const std::shared_ptr<const Thread_placement>& placement, Sort_workspace* workspace)
+{
+  if (!parameters.is_valid())
+  {
+    throw std::invalid_argument("parameters");
+  }
+
+  if (input_vector.size() < 2)
+  {
+    return;
+  }
+
+  // Small vectors are sorted faster without threads.
+  if (input_vector.size() < static_cast<size_t>(parameters.sequential_sort_threshold))
+  {
+    std::sort(input_vector.begin(), input_vector.end());
+
+    return;
+  }
+
+  // Vectors consisting of long ordered runs are merged.
+  if (parameters.adaptive_run_length > 0 && _adaptive_sort(input_vector, parameters, placement, workspace)) // exception
+  {
+    return;
+  }
+
+  // Strings are sorted by specialized algorithm.
+  if constexpr (std::is_same<T, std::string>::value || std::is_same<T, std::string_view>::value)
+  {
+    _string_sort(input_vector, parameters, workspace); // exception
+
+    return;
+  }
+
+  // Large elements are not moved by partitioning: pointers to them are sorted instead.
+  if (is_indirect_sort_used<T>(parameters))
+  {
+    _indirect_quick_sort(input_vector, parameters, placement, workspace); // exception
+
+    return;
+  }
+
+  _sort_by_tasks(input_vector.data(), static_cast<int32_t>(input_vector.size()), parameters, placement); // exception
+}
+
+template<class T, class Compare>
+void Threaded_sort::_sort_by_tasks(T* elements, int32_t size, const Sort_parameters& parameters,
+  const std::shared_ptr<const Thread_placement>& placement, const Compare& compare)
+{
+  assert(elements != nullptr && size >= 2);
+
+  // Create asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> tasks_manager = std::make_shared<Async_tasks_manager>(); // exception
+
+  // Create top level quick sort asynchronous task.
+  std::shared_ptr<Sort_async_task<T, Compare>> sort_async_task = std::make_shared<Sort_async_task<T, Compare>>(
+    elements, size, 0, size - 1, parameters, tasks_manager, placement, compare); // exception
+
+  // Add task to tasks manager.
+  tasks_manager->add_task(sort_async_task);
+
+  // Execute sort synchronous task.
+  sort_async_task->execute();
+
+  // Wait while all asynchronous sort tasks are completed.
+  _wait_for_all_tasks_completion(tasks_manager); // exception
+}
+
+template<class T>
+void Threaded_sort::string_sort(std::vector<T>& input_vector)
+{
+  string_sort(input_vector, get_tuned_parameters<T>()); // exception
+}
+
+template<class T>
+void Threaded_sort::string_sort(std::vector<T>& input_vector, const Sort_parameters& parameters)
+{
+  _string_sort(input_vector, parameters, nullptr); // exception
+}
+
+template<class T>
+void Threaded_sort::string_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+  Sort_workspace& workspace)
+{
+  workspace.reserve(get_workspace_size<T>(static_cast<int32_t>(input_vector.size()), parameters,
+    workspace.get_alignment())); // exception
+
+  _string_sort(input_vector, parameters, &workspace); // exception
+}
+
+template<class T>
+void Threaded_sort::_string_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+  Sort_workspace* workspace)
+{
+  static_assert(std::is_same<T, std::string>::value || std::is_same<T, std::string_view>::value,
+    "Only std::string and std::string_view are supported.");
+
+  if (!parameters.is_valid())
+  {
+    throw std::invalid_argument("parameters");
+  }
+
+  if (input_vector.size() < 2)
+  {
+    return;
+  }
+
+  // Small vectors are sorted faster without threads.
+  if (input_vector.size() < static_cast<size_t>(parameters.sequential_sort_threshold))
+  {
+    std::sort(input_vector.begin(), input_vector.end());
+
+    return;
+  }
+
+  const int32_t size = static_cast<int32_t>(input_vector.size());
+
+  // Scratch buffers are released on return (entries are released before permutation).
+  Sort_workspace::Scope workspace_scope(workspace);
+
+  Workspace_vector<int32_t> sources(size, Workspace_allocator<int32_t>(workspace)); // exception
+
+  {
+    Sort_workspace::Scope entries_scope(workspace);
+
+    Workspace_vector<String_entry> entries(size, Workspace_allocator<String_entry>(workspace)); // exception
+
+    for (int32_t i = 0; i < size; i++)
+    {
+      entries[i].characters = input_vector[i].data();
+      entries[i].length = input_vector[i].size();
+      entries[i].index = i;
+
+      entries[i].load_cache(0);
+    }
+
+    // Create asynchronous tasks manager.
+    std::shared_ptr<Async_tasks_manager> tasks_manager = std::make_shared<Async_tasks_manager>(); // exception
+
+    // Create top level string sort asynchronous task.
+    std::shared_ptr<String_sort_async_task> sort_async_task = std::make_shared<String_sort_async_task>(entries,
+      0, size, 0, parameters, tasks_manager); // exception
+
+    // Add task to tasks manager.
+    tasks_manager->add_task(sort_async_task); // exception
+
+    // Execute sort asynchronous task.
+    sort_async_task->execute();
+
+    // Wait while all asynchronous sort tasks are completed: on error vector is not changed.
+    _wait_for_all_tasks_completion(tasks_manager); // exception
+
+    for (int32_t i = 0; i < size; i++)
+    {
+      sources[i] = entries[i].index;
+    }
+  }
+
+  // Move strings into final position.
+  _permute(input_vector, sources, parameters); // exception
+}
+
+template<class T>
+void Threaded_sort::segmented_sort(std::vector<T>& input_vector, const std::vector<int32_t>& offsets)
+{
+  segmented_sort(input_vector, offsets, get_tuned_parameters<T>()); // exception
+}
+
+template<class T>
+void Threaded_sort::segmented_sort(std::vector<T>& input_vector, const std::vector<int32_t>& offsets,
+  const Sort_parameters& parameters)
+{
+  if (!parameters.is_valid())
+  {
+    throw std::invalid_argument("parameters");
+  }
+
+  if (offsets.empty() || offsets.front() != 0 || offsets.back() != static_cast<int32_t>(input_vector.size()) ||
+    !std::is_sorted(offsets.begin(), offsets.end()))
+  {
+    throw std::invalid_argument("offsets");
+  }
+
+  const int32_t segments_count = static_cast<int32_t>(offsets.size()) - 1;
+
+  // Segments which are sorted by threaded quick sort.
+  const int32_t large_segment_size = std::max(parameters.sequential_sort_threshold, parameters.min_task_size);
+
+  // Estimate cost (n * log(n)) of small segments.
+  double small_segments_cost = 0.0;
+  bool has_large_segments = false;
+
+  for (int32_t segment = 0; segment < segments_count; segment++)
+  {
+    const int32_t size = offsets[segment + 1] - offsets[segment];
+
+    if (size >= large_segment_size)
+    {
+      has_large_segments = true;
+    }
+    else if (size > 1)
+    {
+      small_segments_cost += size * std::log2(static_cast<double>(size));
+    }
+  }
+
+  // Small amount of work is done faster without threads.
+  if (!has_large_segments && input_vector.size() < static_cast<size_t>(parameters.sequential_sort_threshold))
+  {
+    for (int32_t segment = 0; segment < segments_count; segment++)
+    {
+      Segments_sort_async_task<T>::sort_segment(input_vector, offsets[segment], offsets[segment + 1]);
+    }
+
+    return;
+  }
+
+  const int32_t workers_count = get_workers_count();
+
+  const double batch_cost = small_segments_cost / workers_count;
+
+  // Create asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> tasks_manager = std::make_shared<Async_tasks_manager>(); // exception
+
+  try
+  {
+    // Single pass: every batch and every large segment is started as soon as it is found.
+    int32_t batch_first_segment = 0;
+    double current_batch_cost = 0.0;
+
+    for (int32_t segment = 0; segment < segments_count; segment++)
+    {
+      const int32_t left = offsets[segment];
+      const int32_t size = offsets[segment + 1] - left;
+
+      if (size >= large_segment_size)
+      {
+        std::shared_ptr<Async_task> sort_async_task = std::make_shared<Sort_async_task<T>>(input_vector.data(),
+          static_cast<int32_t>(input_vector.size()), left, left + size - 1, parameters, tasks_manager); // exception
+
+        tasks_manager->add_task(sort_async_task); // exception
+
+        sort_async_task->execute();
+      }
+      else if (size > 1)
+      {
+        current_batch_cost += size * std::log2(static_cast<double>(size));
+      }
+
+      const bool is_last_segment = (segment + 1 == segments_count);
+
+      if (current_batch_cost > 0.0 && (current_batch_cost >= batch_cost || is_last_segment))
+      {
+        std::shared_ptr<Async_task> segments_async_task = std::make_shared<Segments_sort_async_task<T>>(
+          input_vector, offsets, batch_first_segment, segment + 1, large_segment_size, tasks_manager); // exception
+
+        tasks_manager->add_task(segments_async_task); // exception
+
+        segments_async_task->execute();
+
+        batch_first_segment = segment + 1;
+        current_batch_cost = 0.0;
+      }
+    }
+  }
+  catch (std::exception&)
+  {
+    // Started tasks use vector: wait for them before error is thrown.
+    tasks_manager->wait_for_all_tasks_completion();
+
+    throw;
+  }
+
+  // Wait while all asynchronous sort tasks are completed.
+  _wait_for_all_tasks_completion(tasks_manager); // exception
+}
+
+template<class T>
+bool Threaded_sort::_adaptive_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+  const std::shared_ptr<const Thread_placement>& placement, Sort_workspace* workspace)
+{
+  assert(parameters.adaptive_run_length > 0);
+
+  const int32_t size = static_cast<int32_t>(input_vector.size());
+
+  const int32_t min_run_length = std::max(parameters.adaptive_run_length, 2);
+
+  const int32_t chunks_count = _get_chunks_count(size, parameters);
+
+  std::vector<std::vector<Natural_run>> chunk_runs(chunks_count); // exception
+
+  // Scan chunks for natural runs.
+  auto get_chunk_first = [size, chunks_count](int32_t chunk)
+  {
+    return static_cast<int32_t>(static_cast<int64_t>(size) * chunk / chunks_count);
+  };
+
+  _run_chunks(chunks_count,
+    [&](int32_t chunk)
+    {
+      Run_scan_async_task<T>::scan(input_vector, get_chunk_first(chunk), get_chunk_first(chunk + 1), min_run_length,
+        chunk_runs[chunk]); // exception
+    },
+    [&](int32_t chunk, const std::shared_ptr<Async_tasks_manager>& tasks_manager)
+    {
+      return std::make_shared<Run_scan_async_task<T>>(input_vector, get_chunk_first(chunk),
+        get_chunk_first(chunk + 1), min_run_length, chunk_runs[chunk], tasks_manager); // exception
+    }); // exception
+
+  // Join runs split by chunk boundaries (run of one element continues run of any direction).
+  std::vector<Natural_run> runs;
+
+  for (const std::vector<Natural_run>& current_chunk_runs : chunk_runs)
+  {
+    for (const Natural_run& run : current_chunk_runs)
+    {
+      if (!runs.empty() && runs.back().last == run.first)
+      {
+        Natural_run& previous_run = runs.back();
+
+        const bool is_descending_boundary = (input_vector[run.first] < input_vector[run.first - 1]);
+
+        const bool is_previous_joinable = (previous_run.get_size() == 1 ||
+          previous_run.is_descending == is_descending_boundary);
+
+        const bool is_current_joinable = (run.get_size() == 1 || run.is_descending == is_descending_boundary);
+
+        if (is_previous_joinable && is_current_joinable)
+        {
+          previous_run.last = run.last;
+          previous_run.is_descending = is_descending_boundary;
+
+          continue;
+        }
+      }
+
+      runs.push_back(run); // exception
+    }
+  }
+
+  runs.erase(std::remove_if(runs.begin(), runs.end(),
+    [min_run_length](const Natural_run& run) { return (run.get_size() < min_run_length); }), runs.end());
+
+  int64_t runs_elements_count = 0;
+
+  for (const Natural_run& run : runs)
+  {
+    runs_elements_count += run.get_size();
+  }
+
+  // Not enough structure: vector is sorted by quick sort.
+  if (runs_elements_count * 2 < size)
+  {
+    return false;
+  }
+
+  // Split vector into ranges: runs and ranges between them. Descending runs are reversed, ranges between runs
+  // are sorted (large ones by threaded quick sort).
+  const int32_t large_range_size = std::max(parameters.sequential_sort_threshold, parameters.min_task_size);
+
+  std::vector<int32_t> range_starts;
+  std::vector<Run_merge_job> jobs;
+
+  // Create asynchronous tasks manager.
+  std::shared_ptr<Async_tasks_manager> tasks_manager = std::make_shared<Async_tasks_manager>(); // exception
+
+  int32_t position = 0;
+
+  try
+  {
+    for (size_t run = 0; run <= runs.size(); run++)
+    {
+      const int32_t gap_last = (run < runs.size()) ? runs[run].first : size;
+
+      if (gap_last > position)
+      {
+        range_starts.push_back(position); // exception
+
+        if (gap_last - position >= large_range_size)
+        {
+          std::shared_ptr<Async_task> sort_async_task = std::make_shared<Sort_async_task<T>>(input_vector.data(),
+            size, position, gap_last - 1, parameters, tasks_manager, placement); // exception
+
+          tasks_manager->add_task(sort_async_task); // exception
+
+          sort_async_task->execute();
+        }
+        else if (gap_last - position > 1)
+        {
+          jobs.push_back({ Run_merge_job::Operation::sort, position, position, gap_last }); // exception
+        }
+      }
+
+      if (run == runs.size())
+      {
+        break;
+      }
+
+      range_starts.push_back(runs[run].first); // exception
+
+      if (runs[run].is_descending)
+      {
+        jobs.push_back({ Run_merge_job::Operation::reverse, runs[run].first, runs[run].first,
+          runs[run].last }); // exception
+      }
+
+      position = runs[run].last;
+    }
+
+    range_starts.push_back(size); // exception
+
+    if (!jobs.empty())
+    {
+      _start_run_merge_jobs(input_vector, jobs, static_cast<T*>(nullptr), tasks_manager); // exception
+    }
+  }
+  catch (std::exception&)
+  {
+    // Started tasks use vector: wait for them before error is thrown.
+    tasks_manager->wait_for_all_tasks_completion();
+
+    throw;
+  }
+
+  _wait_for_all_tasks_completion(tasks_manager); // exception
+
+  if (range_starts.size() <= 2)
+  {
+    return true;
+  }
+
+  std::vector<std::vector<Run_merge_job>> levels;
+
+  _plan_run_merges(range_starts, levels); // exception
+
+  // One merge buffer of size / 2 elements is shared by all merges (see Run_merge_async_task<T>), it is released
+  // on return.
+  Sort_workspace::Scope workspace_scope(workspace);
+
+  Workspace_allocator<T> allocator(workspace);
+
+  const int32_t merge_buffer_size = size / 2;
+
+  auto deallocate = [&allocator, merge_buffer_size](T* elements)
+  {
+    allocator.deallocate(elements, merge_buffer_size);
+  };
+
+  std::unique_ptr<T, decltype(deallocate)> merge_buffer(nullptr, deallocate);
+
+  try
+  {
+    merge_buffer.reset(allocator.allocate(merge_buffer_size)); // exception
+  }
+  catch (std::bad_alloc&)
+  {
+    // Not enough memory: ranges are merged by std::inplace_merge.
+  }
+
+  for (const std::vector<Run_merge_job>& level_jobs : levels)
+  {
+    try
+    {
+      _start_run_merge_jobs(input_vector, level_jobs, merge_buffer.get(), tasks_manager); // exception
+    }
+    catch (std::exception&)
+    {
+      // Started tasks use vector: wait for them before error is thrown.
+      tasks_manager->wait_for_all_tasks_completion();
+
+      throw;
+    }
+
+    _wait_for_all_tasks_completion(tasks_manager); // exception
+  }
+
+  return true;
+}
+
+template<class T>
+void Threaded_sort::_start_run_merge_jobs(std::vector<T>& input_vector, const std::vector<Run_merge_job>& jobs,
+  T* merge_buffer, const std::shared_ptr<Async_tasks_manager>& tasks_manager)
+{
+  assert(!jobs.empty());
+
+  const int32_t workers_count = get_workers_count();
+
+  int64_t jobs_size = 0;
+
+  for (const Run_merge_job& job : jobs)
+  {
+    jobs_size += job.last - job.first;
+  }
+
+  const int64_t batch_size = jobs_size / workers_count;
+
+  const int32_t jobs_count = static_cast<int32_t>(jobs.size());
+
+  int32_t batch_first_job = 0;
+  int64_t current_batch_size = 0;
+
+  for (int32_t job = 0; job < jobs_count; job++)
+  {
+    current_batch_size += jobs[job].last - jobs[job].first;
+
+    if (current_batch_size >= batch_size || job + 1 == jobs_count)
+    {
+      std::shared_ptr<Async_task> merge_async_task = std::make_shared<Run_merge_async_task<T>>(input_vector, jobs,
+        batch_first_job, job + 1, merge_buffer, tasks_manager); // exception
+
+      tasks_manager->add_task(merge_async_task); // exception
+
+      merge_async_task->execute();
+
+      batch_first_job = job + 1;
+      current_batch_size = 0;
+    }
+  }
+}
+
+template<class T>
+void Threaded_sort::multiway_merge(const std::vector<std::vector<T>>& inputs, std::vector<T>& output)
+{
+  multiway_merge(inputs, output, get_tuned_parameters<T>()); // exception
+}
+
+template<class T>
+void Threaded_sort::multiway_merge(const std::vector<std::vector<T>>& inputs, std::vector<T>& output,
+  const Sort_parameters& parameters)
+{
+  std::vector<std::pair<typename std::vector<T>::const_iterator, typename std::vector<T>::const_iterator>> ranges;
+
+  ranges.reserve(inputs.size()); // exception
+
+  for (const std::vector<T>& input : inputs)
+  {
+    ranges.emplace_back(input.begin(), input.end());
+  }
+
+  multiway_merge(ranges, output, parameters); // exception
+}
+
+template<class Iterator>
+void Threaded_sort::multiway_merge(const std::vector<std::pair<Iterator, Iterator>>& ranges,
+  std::vector<typename std::iterator_traits<Iterator>::value_type>& output)
+{
+  multiway_merge(ranges, output, get_tuned_parameters<typename std::iterator_traits<Iterator>::value_type>());
+}
+
+template<class Iterator>
+void Threaded_sort::multiway_merge(const std::vector<std::pair<Iterator, Iterator>>& ranges,
+  std::vector<typename std::iterator_traits<Iterator>::value_type>& output, const Sort_parameters& parameters)
+{
+  if (!parameters.is_valid())
+  {
+    throw std::invalid_argument("parameters");
+  }
+
+  int64_t total_count = 0;
+
+  for (const std::pair<Iterator, Iterator>& range : ranges)
+  {
+    const int64_t count = std::distance(range.first, range.second);
+
+    if (count < 0)
+    {
+      throw std::invalid_argument("ranges");
+    }
+
+    total_count += count;
+  }
+
+  output.clear();
+
+  output.resize(static_cast<size_t>(total_count)); // exception
+
+  if (total_count == 0)
+  {
+    return;
+  }
+
+  const int32_t pieces_count = _get_chunks_count(total_count, parameters);
+
+  // Output is split into equal pieces merged independently.
+  _run_chunks(pieces_count,
+    [&](int32_t piece)
+    {
+      Multiway_merge_async_task<Iterator>::merge(ranges, total_count * piece / pieces_count,
+        total_count * (piece + 1) / pieces_count, output); // exception
+    },
+    [&](int32_t piece, const std::shared_ptr<Async_tasks_manager>& tasks_manager)
+    {
+      return std::make_shared<Multiway_merge_async_task<Iterator>>(ranges, total_count * piece / pieces_count,
+        total_count * (piece + 1) / pieces_count, output, tasks_manager); // exception
+    }); // exception
+}
+
+template<class T>
+void Threaded_sort::merge_batch(std::vector<T>& sorted_vector, std::vector<T>& batch)
+{
+  merge_batch(sorted_vector, batch, get_tuned_parameters<T>()); // exception
+}
+
+template<class T>
+void Threaded_sort::merge_batch(std::vector<T>& sorted_vector, std::vector<T>& batch,
+  const Sort_parameters& parameters)
+{
+  _merge_batch(sorted_vector, batch, parameters, nullptr); // exception
+}
+
+template<class T>
+void Threaded_sort::merge_batch(std::vector<T>& sorted_vector, std::vector<T>& batch,
+  const Sort_parameters& parameters, Sort_workspace& workspace)
+{
+  workspace.reserve(get_workspace_size<T>(static_cast<int32_t>(batch.size()), parameters,
+    workspace.get_alignment())); // exception
+
+  _merge_batch(sorted_vector, batch, parameters, &workspace); // exception
+}
+
+template<class T>
+void Threaded_sort::_merge_batch(std::vector<T>& sorted_vector, std::vector<T>& batch,
+  const Sort_parameters& parameters, Sort_workspace* workspace)
+{
+  if (!parameters.is_valid())
+  {
+    throw std::invalid_argument("parameters");
+  }
+
+  if (&sorted_vector == &batch)
+  {
+    throw std::invalid_argument("batch");
+  }
+
+  if (batch.empty())
+  {
+    return;
+  }
+
+  // Only batch is sorted: on error vector is not changed.
+  _quick_sort(batch, parameters, nullptr, workspace); // exception
+
+  const int32_t size = static_cast<int32_t>(sorted_vector.size());
+  const int32_t batch_size = static_cast<int32_t>(batch.size());
+
+  // Elements which can't be merged in place in parallel are merged by std::inplace_merge.
+  if constexpr (!std::is_default_constructible<T>::value || !std::is_nothrow_move_constructible<T>::value ||
+    !std::is_nothrow_move_assignable<T>::value)
+  {
+    sorted_vector.insert(sorted_vector.end(), std::make_move_iterator(batch.begin()),
+      std::make_move_iterator(batch.end())); // exception
+
+    std::inplace_merge(sorted_vector.begin(), sorted_vector.begin() + size, sorted_vector.end()); // exception
+
+    batch.clear();
+  }
+  else
+  {
+    const int32_t total_size = size + batch_size;
+
+    const int32_t pieces_count = _get_chunks_count(total_size, parameters);
+
+    sorted_vector.resize(total_size); // exception
+
+    std::vector<Batch_merge_piece> pieces;
+
+    // Saved elements are released on return.
+    Sort_workspace::Scope workspace_scope(workspace);
+
+    Workspace_allocator<T> allocator(workspace);
+
+    int32_t saved_count = 0;
+    int32_t constructed_count = 0;
+
+    auto destroy = [&allocator, &saved_count, &constructed_count](T* elements)
+    {
+      for (int32_t i = 0; i < constructed_count; i++)
+      {
+        elements[i].~T();
+      }
+
+      allocator.deallocate(elements, saved_count);
+    };
+
+    std::unique_ptr<T, decltype(destroy)> saved_elements(nullptr, destroy);
+
+    try
+    {
+      typedef typename std::vector<T>::iterator Iterator;
+
+      // Pieces: output is split into equal parts by co-ranks of their boundaries (vector goes first).
+      const std::vector<std::pair<Iterator, Iterator>> ranges = { { sorted_vector.begin(),
+        sorted_vector.begin() + size }, { batch.begin(), batch.end() } };
+
+      std::vector<int64_t> counts;
+
+      pieces.resize(pieces_count); // exception
+
+      for (int32_t piece = 0; piece < pieces_count; piece++)
+      {
+        Multiway_merge_async_task<Iterator>::split(ranges,
+          static_cast<int64_t>(total_size) * (piece + 1) / pieces_count, counts); // exception
+
+        pieces[piece].first = (piece > 0) ? pieces[piece - 1].last : 0;
+        pieces[piece].batch_first = (piece > 0) ? pieces[piece - 1].batch_last : 0;
+        pieces[piece].last = static_cast<int32_t>(counts[0]);
+        pieces[piece].batch_last = static_cast<int32_t>(counts[1]);
+
+        // Previous pieces overwrite the first batch_first elements of piece.
+        pieces[piece].saved_first = saved_count;
+        pieces[piece].saved_count = std::min(pieces[piece].batch_first, pieces[piece].last - pieces[piece].first);
+
+        saved_count += pieces[piece].saved_count;
+      }
+
+      if (saved_count > 0)
+      {
+        if (workspace != nullptr)
+        {
+          workspace->reserve(static_cast<size_t>(saved_count) * sizeof(T)); // exception
+        }
+
+        saved_elements.reset(allocator.allocate(saved_count)); // exception
+      }
+    }
+    catch (std::bad_alloc&)
+    {
+      sorted_vector.resize(size);
+
+      throw;
+    }
+
+    // From here nothing throws except comparisons of elements and failure of waiting for tasks.
+    for (const Batch_merge_piece& piece : pieces)
+    {
+      for (int32_t i = 0; i < piece.saved_count; i++)
+      {
+        new (&saved_elements.get()[constructed_count++]) T(std::move(sorted_vector[piece.first + i]));
+      }
+    }
+
+    // Pieces which tasks can't be created for or which tasks failed to start are merged in calling thread, errors
+    // of comparison are thrown.
+    _run_chunks(pieces_count,
+      [&](int32_t piece)
+      {
+        Batch_merge_async_task<T>::merge(sorted_vector, batch, pieces[piece], saved_elements.get()); // exception
+      },
+      [&](int32_t piece, const std::shared_ptr<Async_tasks_manager>& tasks_manager)
+      {
+        return std::make_shared<Batch_merge_async_task<T>>(sorted_vector, batch, pieces[piece],
+          saved_elements.get(), tasks_manager); // exception
+      },
+      [](Batch_merge_async_task<T>& merge_task)
+      {
+        if (merge_task.is_merge_started())
+        {
+          throw std::exception(*merge_task.get_error());
+        }
+
+        merge_task.merge(); // exception
+      }); // exception
+
+    batch.clear();
+  }
+}
+
+template<class T>
+int32_t Threaded_sort::sort_unique(std::vector<T>& input_vector)
+{
+  return sort_unique(input_vector, get_tuned_parameters<T>()); // exception
+}
+
+template<class T>
+int32_t Threaded_sort::sort_unique(std::vector<T>& input_vector, const Sort_parameters& parameters)
+{
+  // The first element of every group is kept.
+  auto keep_first = [](T&, const T&) {};
+
+  return sort_reduce_by_key(input_vector, keep_first, parameters); // exception
+}
+
+template<class T>
+int32_t Threaded_sort::sort_unique(std::vector<T>& input_vector, const Sort_parameters& parameters,
+  Sort_workspace& workspace)
+{
+  // The first element of every group is kept.
+  auto keep_first = [](T&, const T&) {};
+
+  return sort_reduce_by_key(input_vector, keep_first, parameters, workspace); // exception
+}
+
+template<class T, class Reduce>
+int32_t Threaded_sort::sort_reduce_by_key(std::vector<T>& input_vector, Reduce reduce)
+{
+  return sort_reduce_by_key(input_vector, reduce, get_tuned_parameters<T>()); // exception
+}
+
+template<class T, class Reduce>
+int32_t Threaded_sort::sort_reduce_by_key(std::vector<T>& input_vector, Reduce reduce,
+  const Sort_parameters& parameters)
+{
+  return _sort_reduce_by_key(input_vector, reduce, parameters, nullptr); // exception
+}
+
+template<class T, class Reduce>
+int32_t Threaded_sort::sort_reduce_by_key(std::vector<T>& input_vector, Reduce reduce,
+  const Sort_parameters& parameters, Sort_workspace& workspace)
+{
+  workspace.reserve(get_workspace_size<T>(static_cast<int32_t>(input_vector.size()), parameters,
+    workspace.get_alignment())); // exception
+
+  return _sort_reduce_by_key(input_vector, reduce, parameters, &workspace); // exception
+}
+
+template<class T, class Reduce>
+int32_t Threaded_sort::_sort_reduce_by_key(std::vector<T>& input_vector, Reduce reduce,
+  const Sort_parameters& parameters, Sort_workspace* workspace)
+{
+  _quick_sort(input_vector, parameters, nullptr, workspace); // exception
+
+  const int32_t size = static_cast<int32_t>(input_vector.size());
+
+  if (size == 0)
+  {
+    return 0;
+  }
+
+  const int32_t chunks_count = _get_chunks_count(size, parameters);
+
+  // Groups of equal elements are never split between chunks.
+  std::vector<Reduce_chunk> chunks;
+
+  Reduce_chunk::split(input_vector, chunks_count, chunks); // exception
+
+  _execute_reduce_stage(input_vector, chunks, reduce, static_cast<T*>(nullptr),
+    Reduce_chunk::Stage::reduce); // exception
+
+  int32_t moved_count = 0;
+
+  const int32_t results_count = Reduce_chunk::set_outputs(chunks, moved_count);
+
+  if (moved_count == 0)
+  {
+    return results_count;
+  }
+
+  // Saved results are released on return.
+  Sort_workspace::Scope workspace_scope(workspace);
+
+  Workspace_allocator<T> allocator(workspace);
+
+  auto deallocate = [&allocator, moved_count](T* elements) { allocator.deallocate(elements, moved_count); };
+
+  std::unique_ptr<T, decltype(deallocate)> saved_elements(nullptr, deallocate);
+
+  // Results are moved through saved elements in parallel if they can't throw on move.
+  if constexpr (std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value)
+  {
+    if (chunks_count > 1)
+    {
+      try
+      {
+        if (workspace != nullptr)
+        {
+          workspace->reserve(static_cast<size_t>(moved_count) * sizeof(T)); // exception
+        }
+
+        saved_elements.reset(allocator.allocate(moved_count)); // exception
+      }
+      catch (std::bad_alloc&)
+      {
+        // Not enough memory: results are moved in calling thread.
+      }
+    }
+  }
+
+  if (saved_elements != nullptr)
+  {
+    // From here nothing throws except failure of waiting for tasks.
+    _execute_reduce_stage(input_vector, chunks, reduce, saved_elements.get(), Reduce_chunk::Stage::save); // exception
+
+    _execute_reduce_stage(input_vector, chunks, reduce, saved_elements.get(),
+      Reduce_chunk::Stage::restore); // exception
+  }
+  else
+  {
+    // Results are moved to the left: chunks are moved in order.
+    for (const Reduce_chunk& chunk : chunks)
+    {
+      if (chunk.output != chunk.first)
+      {
+        std::move(input_vector.begin() + chunk.first, input_vector.begin() + chunk.first + chunk.count,
+          input_vector.begin() + chunk.output); // exception
+      }
+    }
+  }
+
+  return results_count;
+}
+
+template<class T, class Projection>
+void Threaded_sort::sort_by_key(std::vector<T>& input_vector, Projection projection)
+{
+  typedef typename std::decay<typename std::invoke_result<Projection&, const T&>::type>::type Key;
+
+  sort_by_key(input_vector, projection, get_tuned_parameters<Key_entry<Key>>()); // exception
+}
+
+template<class T, class Projection>
+void Threaded_sort::sort_by_key(std::vector<T>& input_vector, Projection projection, const Sort_parameters& parameters)
+{
+  sort_by_key(input_vector, projection, std::less<>(), parameters); // exception
+}
+
+template<class T, class Projection, class Compare>
+void Threaded_sort::sort_by_key(std::vector<T>& input_vector, Projection projection, Compare compare)
+{
+  typedef typename std::decay<typename std::invoke_result<Projection&, const T&>::type>::type Key;
+
+  sort_by_key(input_vector, projection, compare, get_tuned_parameters<Key_entry<Key>>()); // exception
+}
+
+template<class T, class Projection, class Compare>
+void Threaded_sort::sort_by_key(std::vector<T>& input_vector, Projection projection, Compare compare,
+  const Sort_parameters& parameters)
+{
+  _sort_by_key(input_vector, projection, compare, parameters, nullptr); // exception
+}
+
+template<class T, class Projection>
+void Threaded_sort::sort_by_key(std::vector<T>& input_vector, Projection projection,
+  const Sort_parameters& parameters, Sort_workspace& workspace)
+{
+  sort_by_key(input_vector, projection, std::less<>(), parameters, workspace); // exception
+}
+
+template<class T, class Projection, class Compare>
+void Threaded_sort::sort_by_key(std::vector<T>& input_vector, Projection projection, Compare compare,
+  const Sort_parameters& parameters, Sort_workspace& workspace)
+{
+  typedef typename std::decay<typename std::invoke_result<Projection&, const T&>::type>::type Key;
+
+  workspace.reserve(_get_sort_by_key_workspace_size<T, Key>(static_cast<int32_t>(input_vector.size()), parameters,
+    workspace.get_alignment())); // exception
+
+  _sort_by_key(input_vector, projection, compare, parameters, &workspace); // exception
+}
+
+template<class T, class Projection, class Compare>
+void Threaded_sort::_sort_by_key(std::vector<T>& input_vector, Projection& projection, const Compare& compare,
+  const Sort_parameters& parameters, Sort_workspace* workspace)
+{
+  typedef typename std::decay<typename std::invoke_result<Projection&, const T&>::type>::type Key;
+
+  if (!parameters.is_valid())
+  {
+    throw std::invalid_argument("parameters");
+  }
+
+  const int32_t size = static_cast<int32_t>(input_vector.size());
+
+  if (size < 2)
+  {
+    return;
+  }
+
+  // Buffers are released on return.
+  Sort_workspace::Scope workspace_scope(workspace);
+
+  Workspace_vector<int32_t> sources(size, Workspace_allocator<int32_t>(workspace)); // exception
+
+  {
+    // Key entries are released before elements are moved.
+    Sort_workspace::Scope entries_scope(workspace);
+
+    // Sort entries: on error vector is not changed.
+    if (workspace == nullptr)
+    {
+      std::vector<Key_entry<Key>> entries(size); // exception
+
+      _sort_key_entries(input_vector, projection, compare, parameters, entries, sources); // exception
+    }
+    else
+    {
+      Workspace_vector<Key_entry<Key>> entries(size, Workspace_allocator<Key_entry<Key>>(workspace)); // exception
+
+      _sort_key_entries(input_vector, projection, compare, parameters, entries, sources); // exception
+    }
+  }
+
+  // Large vectors are permuted in place in parallel.
+  if constexpr (std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value)
+  {
+    if (size >= parameters.sequential_sort_threshold)
+    {
+      _permute(input_vector, sources, parameters); // exception
+
+      return;
+    }
+  }
+
+  // Elements are moved into sorted vector.
+  std::vector<T> sorted_vector;
+
+  sorted_vector.reserve(size); // exception
+
+  for (int32_t source : sources)
+  {
+    sorted_vector.push_back(std::move(input_vector[source])); // exception
+  }
+
+  input_vector.swap(sorted_vector);
+}
+
+template<class T, class Projection, class Compare, class Key, class Entry_allocator>
+void Threaded_sort::_sort_key_entries(const std::vector<T>& input_vector, Projection& projection,
+  const Compare& compare, const Sort_parameters& parameters, std::vector<Key_entry<Key>, Entry_allocator>& entries,
+  Workspace_vector<int32_t>& sources)
+{
+  const int32_t size = static_cast<int32_t>(input_vector.size());
+
+  assert(static_cast<int32_t>(entries.size()) == size && static_cast<int32_t>(sources.size()) == size);
+
+  const int32_t chunks_count = _get_chunks_count(size, parameters);
+
+  auto get_chunk_first = [size, chunks_count](int32_t chunk)
+  {
+    return static_cast<int32_t>(static_cast<int64_t>(size) * chunk / chunks_count);
+  };
+
+  _run_chunks(chunks_count,
+    [&](int32_t chunk)
+    {
+      Key_extract_async_task<T, Key, Projection>::extract(input_vector, entries.data(), get_chunk_first(chunk),
+        get_chunk_first(chunk + 1), projection); // exception
+    },
+    [&](int32_t chunk, const std::shared_ptr<Async_tasks_manager>& tasks_manager)
+    {
+      return std::make_shared<Key_extract_async_task<T, Key, Projection>>(input_vector, entries.data(),
+        get_chunk_first(chunk), get_chunk_first(chunk + 1), projection, tasks_manager); // exception
+    }); // exception
+
+  if constexpr (std::is_same<Compare, std::less<>>::value &&
+    std::is_same<Entry_allocator, std::allocator<Key_entry<Key>>>::value)
+  {
+    _quick_sort(entries, parameters, nullptr, nullptr); // exception
+  }
+  else
+  {
+    const Key_entry_compare<Key, Compare> entry_compare = { compare };
+
+    if (size < parameters.sequential_sort_threshold)
+    {
+      std::sort(entries.begin(), entries.end(), entry_compare); // exception
+    }
+    else
+    {
+      _sort_by_tasks(entries.data(), size, parameters, nullptr, entry_compare); // exception
+    }
+  }
+
+  for (int32_t i = 0; i < size; i++)
+  {
+    sources[i] = entries[i].index;
+  }
+}
+
+template<class T>
+void Threaded_sort::sharded_sort(std::vector<T>& input_vector, int32_t processes_count)
+{
+  sharded_sort(input_vector, processes_count, get_tuned_parameters<T>()); // exception
+}
+
+template<class T>
+void Threaded_sort::sharded_sort(std::vector<T>& input_vector, int32_t processes_count,
+  const Sort_parameters& parameters)
+{
+  static_assert(std::is_trivially_copyable<T>::value, "Elements should be trivially copyable.");
+
+  if (processes_count <= 0)
+  {
+    throw std::invalid_argument("processes_count");
+  }
+
+  if (!parameters.is_valid())
+  {
+    throw std::invalid_argument("parameters");
+  }
+
+  const int32_t size = static_cast<int32_t>(input_vector.size());
+
+  // Small vectors are sorted faster without worker processes.
+  const int32_t ranges_count = (!Shared_memory_region::is_supported() || size < parameters.sequential_sort_threshold) ?
+    1 : std::max<int32_t>(std::min<int32_t>(processes_count, size / parameters.min_task_size), 1);
+
+  if (ranges_count == 1)
+  {
+    _quick_sort(input_vector, parameters, nullptr, nullptr); // exception
+
+    return;
+  }
+
+  _sharded_sort(input_vector, ranges_count, parameters); // exception
+}
+
+template<class T>
+bool Threaded_sort::is_indirect_sort_used(const Sort_parameters& parameters)
+{
+  return (sizeof(T) > sizeof(Element_pointer<T>) && std::is_nothrow_move_constructible<T>::value &&
+    std::is_nothrow_move_assignable<T>::value && parameters.indirect_sort_element_size > 0 &&
+    sizeof(T) >= static_cast<size_t>(parameters.indirect_sort_element_size));
+}
+
+template<class T>
+void Threaded_sort::_indirect_quick_sort(std::vector<T>& input_vector, const Sort_parameters& parameters,
+  const std::shared_ptr<const Thread_placement>& placement, Sort_workspace* workspace)
+{
+  // Element_pointer<T> is never sorted indirectly: this stops recursive instantiation.
+  if constexpr (sizeof(T) > sizeof(Element_pointer<T>) && std::is_nothrow_move_constructible<T>::value &&
+    std::is_nothrow_move_assignable<T>::value)
+  {
+    const int32_t size = static_cast<int32_t>(input_vector.size());
+
+    // Scratch buffers are released on return (pointers are released before permutation).
+    Sort_workspace::Scope workspace_scope(workspace);
+
+    Workspace_vector<int32_t> sources(size, Workspace_allocator<int32_t>(workspace)); // exception
+
+    {
+      Sort_workspace::Scope pointers_scope(workspace);
+
+      Workspace_vector<Element_pointer<T>> pointers(size,
+        Workspace_allocator<Element_pointer<T>>(workspace)); // exception
+
+      for (int32_t i = 0; i < size; i++)
+      {
+        pointers[i].element = &input_vector[i];
+      }
+
+      // Sort pointers: on error vector is not changed.
+      _sort_by_tasks(pointers.data(), size, parameters, placement); // exception
+
+      for (int32_t i = 0; i < size; i++)
+      {
+        sources[i] = static_cast<int32_t>(pointers[i].element - input_vector.data());
+      }
+    }
+
+    _permute(input_vector, sources, parameters); // exception
+  }
+  else
+  {
+    assert(false);
+  }
+}
+
+template<class T>
+void Threaded_sort::_permute(std::vector<T>& input_vector, Workspace_vector<int32_t>& sources,
+  const Sort_parameters& parameters)
+{
+  const int32_t size = static_cast<int32_t>(input_vector.size());
+
+  assert(sources.size() == input_vector.size());
+
+  // Scratch buffers are reserved once (see _get_permute_workspace_size()).
+  const Workspace_allocator<int32_t> allocator = sources.get_allocator();
+
+  // List cycles of permutation (elements which are already in final position are skipped): every cycle has
+  // at least 2 elements.
+  Workspace_vector<int32_t> order(allocator);
+  Workspace_vector<int32_t> cycle_starts(allocator);
+
+  order.reserve(size); // exception
+  cycle_starts.reserve(size / 2 + 1); // exception
+
+  for (int32_t i = 0; i < size; i++)
+  {
+    if (sources[i] < 0 || sources[i] == i)
+    {
+      continue;
+    }
+
+    cycle_starts.push_back(static_cast<int32_t>(order.size())); // exception
+
+    int32_t j = i;
+
+    do
+    {
+      order.push_back(j);
+
+      const int32_t source = sources[j];
+
+      sources[j] = -1;
+
+      j = source;
+    } while (j != i);
+  }
+
+  cycle_starts.push_back(static_cast<int32_t>(order.size())); // exception
+
+  const int32_t order_size = static_cast<int32_t>(order.size());
+
+  if (order_size == 0)
+  {
+    return;
+  }
+
+  const int32_t chunks_count = _get_chunks_count(order_size, parameters);
+
+  Workspace_vector<int32_t> chunk_starts(chunks_count + 1, allocator); // exception
+
+  for (int32_t chunk = 0; chunk <= chunks_count; chunk++)
+  {
+    chunk_starts[chunk] = static_cast<int32_t>(static_cast<int64_t>(order_size) * chunk / chunks_count);
+  }
+
+  // Elements read by one chunk and overwritten by another one: first element of chunk inside cycle
+  // and start of cycle which crosses chunks boundary.
+  Workspace_vector<int32_t> saved_positions(allocator);
+
+  saved_positions.reserve(2 * chunks_count); // exception
+
+  for (int32_t chunk = 1; chunk < chunks_count; chunk++)
+  {
+    const int32_t boundary = chunk_starts[chunk];
+
+    const int32_t cycle_start = *(std::upper_bound(cycle_starts.begin(), cycle_starts.end(), boundary) - 1);
+
+    if (cycle_start < boundary)
+    {
+      saved_positions.push_back(cycle_start); // exception
+      saved_positions.push_back(boundary); // exception
+    }
+  }
+
+  std::sort(saved_positions.begin(), saved_positions.end());
+
+  saved_positions.erase(std::unique(saved_positions.begin(), saved_positions.end()), saved_positions.end());
+
+  const size_t saved_count = saved_positions.size();
+
+  Workspace_allocator<T> elements_allocator(allocator);
+
+  auto deallocate = [&elements_allocator, saved_count](T* elements)
+  {
+    elements_allocator.deallocate(elements, saved_count);
+  };
+
+  std::unique_ptr<T, decltype(deallocate)> saved_elements(
+    (saved_count > 0) ? elements_allocator.allocate(saved_count) : nullptr, deallocate); // exception
+
+  // From here nothing throws until all elements are moved (except failure of waiting for tasks).
+  for (size_t i = 0; i < saved_positions.size(); i++)
+  {
+    new (&saved_elements.get()[i]) T(std::move(input_vector[order[saved_positions[i]]]));
+  }
+
+  // Chunks which tasks can't be created for or which tasks failed to start are permuted in calling thread.
+  _run_chunks(chunks_count,
+    [&](int32_t chunk)
+    {
+      Permute_async_task<T>::permute(input_vector, order, cycle_starts, saved_positions, saved_elements.get(),
+        chunk_starts[chunk], chunk_starts[chunk + 1]);
+    },
+    [&](int32_t chunk, const std::shared_ptr<Async_tasks_manager>& tasks_manager)
+    {
+      return std::make_shared<Permute_async_task<T>>(input_vector, order, cycle_starts, saved_positions,
+        saved_elements.get(), chunk_starts[chunk], chunk_starts[chunk + 1], tasks_manager); // exception
+    },
+    [](Permute_async_task<T>& permute_task)
+    {
+      permute_task.permute();
+    }); // exception
+
+  for (size_t i = 0; i < saved_positions.size(); i++)
+  {
+    saved_elements.get()[i].~T();
+  }
+}
+
+template<class Process_chunk, class Create_task>
+void Threaded_sort::_run_chunks(int32_t chunks_count, Process_chunk process_chunk, Create_task create_task)
+{
+  _run_chunks(chunks_count, process_chunk, create_task,
+    [](Async_task& task)
+    {
+      throw std::exception(*task.get_error());
+    }); // exception
+}
+
+template<class Process_chunk, class Create_task, class Handle_failed_task>
+void Threaded_sort::_run_chunks(int32_t chunks_count, Process_chunk process_chunk, Create_task create_task,
+  Handle_failed_task handle_failed_task)
+{
+  typedef typename std::invoke_result<Create_task&, int32_t,
+    const std::shared_ptr<Async_tasks_manager>&>::type Task_pointer;
+
+  assert(chunks_count >= 1);
+
+  std::shared_ptr<Async_tasks_manager> tasks_manager;
+
+  std::vector<Task_pointer> tasks;
+
+  if (chunks_count > 1)
+  {
+    try
+    {
+      tasks_manager = std::make_shared<Async_tasks_manager>(); // exception
+
+      tasks.reserve(chunks_count - 1); // exception
+    }
+    catch (std::bad_alloc&)
+    {
+      // Not enough memory for tasks: all chunks are processed in calling thread.
+      tasks_manager = nullptr;
+    }
+  }
+
+  try
+  {
+    for (int32_t chunk = 1; chunk < chunks_count; chunk++)
+    {
+      Task_pointer task;
+
+      if (tasks_manager != nullptr)
+      {
+        try
+        {
+          task = create_task(chunk, tasks_manager); // exception
+
+          tasks_manager->add_task(task); // exception
+        }
+        catch (std::bad_alloc&)
+        {
+          task = nullptr;
+        }
+      }
+
+      if (task == nullptr)
+      {
+        // Not enough memory for task: chunk is processed in calling thread.
+        process_chunk(chunk); // exception
+
+        continue;
+      }
+
+      task->execute();
+
+      tasks.push_back(task);
+    }
+
+    process_chunk(0); // exception
+  }
+  catch (std::exception&)
+  {
+    // Started tasks use data of chunks: wait for them before error is thrown.
+    if (tasks_manager != nullptr)
+    {
+      tasks_manager->wait_for_all_tasks_completion();
+    }
+
+    throw;
+  }
+
+  if (tasks_manager != nullptr)
+  {
+    tasks_manager->wait_for_all_tasks_completion(); // exception
+  }
+
+  for (const Task_pointer& task : tasks)
+  {
+    if (task->is_failed())
+    {
+      handle_failed_task(*task); // exception
+    }
+  }
+}
+
+template<class T, class Reduce>
+void Threaded_sort::_execute_reduce_stage(std::vector<T>& input_vector, std::vector<Reduce_chunk>& chunks,
+  Reduce& reduce, T* saved_elements, Reduce_chunk::Stage stage)
+{
+  // Errors of reduction are thrown, chunks of tasks which failed to start moving are processed in calling thread.
+  _run_chunks(static_cast<int32_t>(chunks.size()),
+    [&](int32_t chunk)
+    {
+      Reduce_async_task<T, Reduce>::execute_stage(input_vector, chunks[chunk], reduce, saved_elements,
+        stage); // exception
+    },
+    [&](int32_t chunk, const std::shared_ptr<Async_tasks_manager>& tasks_manager)
+    {
+      return std::make_shared<Reduce_async_task<T, Reduce>>(input_vector, chunks[chunk], reduce, saved_elements,
+        stage, tasks_manager); // exception
+    },
+    [stage](Reduce_async_task<T, Reduce>& reduce_task)
+    {
+      if (stage == Reduce_chunk::Stage::reduce)
+      {
+        throw std::exception(*reduce_task.get_error());
+      }
+
+      reduce_task.execute_stage();
+    }); // exception
+}
+
+template<class T>
+void Threaded_sort::_execute_shard_stage(const std::vector<T>& input_vector, const std::vector<T>& splitters,
+  std::vector<int32_t>& element_ranges, T* output, std::vector<Shard_chunk>& chunks, Shard_chunk::Stage stage)
+{
+  // Errors of comparison are thrown, chunks of tasks which failed to start copying are processed in calling thread.
+  _run_chunks(static_cast<int32_t>(chunks.size()),
+    [&](int32_t chunk)
+    {
+      Shard_scatter_async_task<T>::execute_stage(input_vector, splitters, element_ranges, output, chunks[chunk],
+        stage); // exception
+    },
+    [&](int32_t chunk, const std::shared_ptr<Async_tasks_manager>& tasks_manager)
+    {
+      return std::make_shared<Shard_scatter_async_task<T>>(input_vector, splitters, element_ranges, output,
+        chunks[chunk], stage, tasks_manager); // exception
+    },
+    [stage](Shard_scatter_async_task<T>& scatter_task)
+    {
+      if (stage == Shard_chunk::Stage::count)
+      {
+        throw std::exception(*scatter_task.get_error());
+      }
+
+      scatter_task.execute_stage();
+    }); // exception
+}
+
+template<class T>
+void Threaded_sort::_sharded_sort(std::vector<T>& input_vector, int32_t ranges_count,
+  const Sort_parameters& parameters)
+{
+  const int32_t size = static_cast<int32_t>(input_vector.size());
+
+  assert(ranges_count >= 2 && ranges_count <= size);
+
+  // Splitters are taken from sorted samples of evenly spaced elements.
+  std::vector<T> splitters;
+
+  {
+    const int32_t samples_count = std::min<int32_t>(size, ranges_count * s_sharded_sort_samples_per_range);
+
+    std::vector<T> samples;
+
+    samples.reserve(samples_count); // exception
+
+    for (int32_t sample = 0; sample < samples_count; sample++)
+    {
+      samples.push_back(input_vector[(2 * static_cast<int64_t>(sample) + 1) * size / (2 * samples_count)]);
+    }
+
+    std::sort(samples.begin(), samples.end()); // exception
+
+    splitters.reserve(ranges_count - 1); // exception
+
+    for (int32_t range = 1; range < ranges_count; range++)
+    {
+      splitters.push_back(samples[static_cast<int64_t>(range) * samples_count / ranges_count]);
+    }
+  }
+
+  Shared_memory_region region(static_cast<size_t>(size) * sizeof(T)); // exception
+
+  T* const sorted_elements = static_cast<T*>(region.get_data());
+
+  // Elements are scattered once into their ranges in shared memory by chunks in parallel: histograms of chunks
+  // are counted first, then every chunk copies its elements into its own slots of ranges.
+  std::vector<int32_t> range_starts(ranges_count + 1, 0); // exception
+
+  {
+    std::vector<int32_t> element_ranges(size); // exception
+
+    const int32_t chunks_count = _get_chunks_count(size, parameters);
+
+    std::vector<Shard_chunk> chunks(chunks_count); // exception
+
+    for (int32_t chunk = 0; chunk < chunks_count; chunk++)
+    {
+      chunks[chunk].first = static_cast<int32_t>(static_cast<int64_t>(size) * chunk / chunks_count);
+      chunks[chunk].last = static_cast<int32_t>(static_cast<int64_t>(size) * (chunk + 1) / chunks_count);
+      chunks[chunk].range_positions.resize(ranges_count); // exception
+    }
+
+    _execute_shard_stage(input_vector, splitters, element_ranges, sorted_elements, chunks,
+      Shard_chunk::Stage::count); // exception
+
+    // Output positions: ranges follow each other, chunks follow each other inside range.
+    int32_t position = 0;
+
+    for (int32_t range = 0; range < ranges_count; range++)
+    {
+      range_starts[range] = position;
+
+      for (Shard_chunk& chunk : chunks)
+      {
+        const int32_t count = chunk.range_positions[range];
+
+        chunk.range_positions[range] = position;
+
+        position += count;
+      }
+    }
+
+    range_starts[ranges_count] = position;
+
+    _execute_shard_stage(input_vector, splitters, element_ranges, sorted_elements, chunks,
+      Shard_chunk::Stage::scatter); // exception
+  }
+
+  // Sorts range in place in shared memory by threaded quick sort: worker process touches only its own slice.
+  auto sort_range = [sorted_elements, &range_starts, &parameters](int32_t range)
+  {
+    const int32_t count = range_starts[range + 1] - range_starts[range];
+
+    if (count < 2)
+    {
+      return;
+    }
+
+    if (count < parameters.sequential_sort_threshold)
+    {
+      std::sort(sorted_elements + range_starts[range], sorted_elements + range_starts[range + 1]); // exception
+
+      return;
+    }
+
+    _sort_by_tasks(sorted_elements + range_starts[range], count, parameters, nullptr); // exception
+  };
+
+  std::vector<int32_t> process_ids;
+
+  process_ids.reserve(ranges_count - 1); // exception
+
+  try
+  {
+    // The first range is sorted by calling process, others by worker processes (empty ranges are skipped).
+    for (int32_t range = 1; range < ranges_count; range++)
+    {
+      if (range_starts[range] < range_starts[range + 1])
+      {
+        process_ids.push_back(_start_worker_process([&sort_range, range]() { sort_range(range); })); // exception
+      }
+    }
+
+    sort_range(0); // exception
+  }
+  catch (std::exception&)
+  {
+    // Started processes write into shared memory: wait for them before error is thrown.
+    _wait_for_worker_processes(process_ids);
+
+    throw;
+  }
+
+  if (!_wait_for_worker_processes(process_ids))
+  {
+    throw std::runtime_error("Worker process of sharded sort failed.");
+  }
+
+  std::copy(sorted_elements, sorted_elements + size, input_vector.begin());
+}
+
+template<class T>
+size_t Threaded_sort::get_workspace_size(int32_t size, const Sort_parameters& parameters, size_t alignment)
+{
+  if (!parameters.is_valid() || size < 2 || size < parameters.sequential_sort_threshold)
+  {
+    return 0;
+  }
+
+  // Every buffer starts at aligned address.
+  auto get_buffer_size = [alignment](size_t count, size_t element_size)
+  {
+    return ((count * element_size + alignment - 1) / alignment * alignment);
+  };
+
+  // Merge buffer of adaptive sort is released before string sort or indirect sort is started.
+  const size_t merge_buffer_size = (parameters.adaptive_run_length > 0) ? get_buffer_size(size / 2, sizeof(T)) : 0;
+
+  // Sources are kept during permutation, entries and pointers are released before it.
+  size_t scratch_size = 0;
+
+  if constexpr (std::is_same<T, std::string>::value || std::is_same<T, std::string_view>::value)
+  {
+    scratch_size = get_buffer_size(size, sizeof(int32_t)) + std::max(get_buffer_size(size, sizeof(String_entry)),
+      _get_permute_workspace_size<T>(size, parameters, alignment));
+  }
+  else if constexpr (sizeof(T) > sizeof(Element_pointer<T>) && std::is_nothrow_move_constructible<T>::value &&
+    std::is_nothrow_move_assignable<T>::value)
+  {
+    if (is_indirect_sort_used<T>(parameters))
+    {
+      scratch_size = get_buffer_size(size, sizeof(int32_t)) + std::max(get_buffer_size(size,
+        sizeof(Element_pointer<T>)), _get_permute_workspace_size<T>(size, parameters, alignment));
+    }
+  }
+
+  return std::max(merge_buffer_size, scratch_size);
+}
+
+template<class T, class Key>
+size_t Threaded_sort::_get_sort_by_key_workspace_size(int32_t size, const Sort_parameters& parameters,
+  size_t alignment)
+{
+  if (!parameters.is_valid() || size < 2)
+  {
+    return 0;
+  }
+
+  auto get_buffer_size = [alignment](size_t count, size_t element_size)
+  {
+    return ((count * element_size + alignment - 1) / alignment * alignment);
+  };
+
+  // Sources are kept during permutation, entries are released before it.
+  size_t permute_size = 0;
+
+  if constexpr (std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value)
+  {
+    if (size >= parameters.sequential_sort_threshold)
+    {
+      permute_size = _get_permute_workspace_size<T>(size, parameters, alignment);
+    }
+  }
+
+  return get_buffer_size(size, sizeof(int32_t)) + std::max(get_buffer_size(size, sizeof(Key_entry<Key>)),
+    permute_size);
+}
+
+template<class T>
+size_t Threaded_sort::_get_permute_workspace_size(int32_t size, const Sort_parameters& parameters, size_t alignment)
+{
+  auto get_buffer_size = [alignment](size_t count, size_t element_size)
+  {
+    return ((count * element_size + alignment - 1) / alignment * alignment);
+  };
+
+  // Count of chunks is the largest when all elements are permuted.
+  const int32_t chunks_count = _get_chunks_count(size, parameters);
+
+  // Order, cycle starts, chunk starts, saved positions and saved elements.
+  return get_buffer_size(size, sizeof(int32_t)) + get_buffer_size(size / 2 + 1, sizeof(int32_t)) +
+    get_buffer_size(chunks_count + 1, sizeof(int32_t)) + get_buffer_size(2 * chunks_count, sizeof(int32_t)) +
+    get_buffer_size(2 * chunks_count, sizeof(T));
+}
+
+template<class T>
+Sort_parameters Threaded_sort::get_tuned_parameters()
+{
+  std::lock_guard<std::mutex> lock(s_tuning_profile_mutex);
+
+  _load_tuning_profile_once();
+
+  return s_tuning_profile.get_parameters(typeid(T).name(), static_cast<int32_t>(sizeof(T)));
 }
 
 } // My_cpp_libs
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file tuning_profile.h
+/// @brief Interface of the Tuning_profile class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TUNING_PROFILE_H_5D2B8E41_A7C3_4F19_B6E0_3C94D1A7F258
+#define TUNING_PROFILE_H_5D2B8E41_A7C3_4F19_B6E0_3C94D1A7F258
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Tuning_profile: sort parameters calibrated on current machine for several element types.
+///
+/// Profile is stored in text file: line "version <format version>" followed by one line per element type:
+///   <element size> <max recursion depth> <min task size> <insertion sort threshold> <sequential sort threshold>
+///   <indirect sort element size> <adaptive run length> <type>
+/// Lines started with '#' are comments. Files without version line (version 1) have no indirect sort element size
+/// and adaptive run length: they get default values.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Tuning_profile final
+{
+public:
+
+  /// @brief Constructor: creates empty profile.
+  Tuning_profile();
+
+  /// @brief Destructor.
+  ~Tuning_profile();
+
+  /// @brief Checks if profile contains no parameters.
+  bool is_empty() const;
+
+  /// @brief Sets parameters for element type (replaces previous ones).
+  /// @param type_name Name of element type (typeid(T).name(), should be not empty).
+  /// @param element_size Size of element in bytes (should be positive value).
+  /// @param parameters Sort parameters (should be valid).
+  /// @exception std::invalid_argument Invalid value of some argument.
+  /// @exception std::bad_alloc
+  void set_parameters(const std::string& type_name, int32_t element_size, const Sort_parameters& parameters);
+
+  /// @brief Gets parameters for element type. If type is not found then parameters of type with
+  ///        the nearest element size are returned. Empty profile returns default parameters.
+  /// @param type_name Name of element type (typeid(T).name()).
+  /// @param element_size Size of element in bytes.
+  Sort_parameters get_parameters(const std::string& type_name, int32_t element_size) const;
+
+  /// @brief Loads profile from file (replaces current parameters).
+  /// @param file_path Path to profile file.
+  /// @exception std::runtime_error File can't be read, has invalid format or unsupported version.
+  /// @exception std::bad_alloc
+  void load(const std::string& file_path);
+
+  /// @brief Saves profile to file.
+  /// @param file_path Path to profile file.
+  /// @exception std::runtime_error File can't be written.
+  void save(const std::string& file_path) const;
+
+private:
+
+  // Nested structs.
+
+  /// @brief Parameters of one element type.
+  struct Entry
+  {
+    std::string type_name;
+    int32_t element_size;
+    Sort_parameters parameters;
+  };
+
+  // Private fields.
+
+  // Parameters of element types.
+  std::vector<Entry> m_entries;
+}; // class Tuning_profile
+
+} // My_cpp_libs
+
+#endif // TUNING_PROFILE_H_5D2B8E41_A7C3_4F19_B6E0_3C94D1A7F258
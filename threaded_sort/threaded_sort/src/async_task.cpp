@@ -53,7 +53,11 @@ void Async_task::execute()
 
   try
   {
-    m_thread = thread(&Async_task::_do_in_background, this); // exception
+    // Thread function waits until m_thread is assigned: otherwise completed task can be joined (and deleted)
+    // before it gets its thread.
+    lock_guard<mutex> lock(m_thread_mutex);
+
+    m_thread = thread(&Async_task::_run, this); // exception
   }
   catch (system_error& error)
   {
@@ -88,6 +92,15 @@ void Async_task::_on_error(const shared_ptr<std::exception>& error)
   _set_status(Status::completed);
 }
 
+void Async_task::_run()
+{
+  {
+    lock_guard<mutex> lock(m_thread_mutex);
+  }
+
+  _do_in_background();
+}
+
 int32_t Async_task::_get_next_task_id()
 {
   int32_t task_id = s_netxt_task_id++;
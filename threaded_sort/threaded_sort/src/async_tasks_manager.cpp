@@ -59,44 +59,52 @@ void Async_tasks_manager::handle_task_completion(int32_t task_id, const std::sha
 {
   assert(task_id >= 0);
 
-  lock_guard<mutex>lock(m_common_mutex);
+  // Completed tasks taken from the list: their threads are joined when mutex is unlocked.
+  list<shared_ptr<Async_task>> tasks_to_join;
 
-  try
   {
-    // Join completed tasks (which can be joined) and remove them. 
-    // Otherwise deleting of completed tasks causes error!
-    _join_and_remove_completed_tasks_which_can_be_joined(); // exception
+    lock_guard<mutex>lock(m_common_mutex);
 
-    // Find task by ID.
-    auto& task_iterator = m_active_tasks_map.find(task_id);
+    try
+    {
+      // Take previously completed tasks (this task is never among them, so thread is not joined by itself).
+      tasks_to_join.splice(tasks_to_join.end(), m_completed_tasks_list);
+
+      // Find task by ID.
+      auto task_iterator = m_active_tasks_map.find(task_id);
+
+      if (task_iterator != m_active_tasks_map.end())
+      { // Task was found.
 
-    if (task_iterator != m_active_tasks_map.end())
-    { // Task was found.
+        shared_ptr<Async_task> async_task = task_iterator->second;
 
-      shared_ptr<Async_task> async_task = task_iterator->second;
+        // Remove task from map.
+        m_active_tasks_map.erase(task_iterator);
 
-      // Remove task from map.
-      m_active_tasks_map.erase(task_iterator);
+        m_completed_tasks_list.push_back(async_task); // exception
+      }
+      else
+      {
+        // Task with given ID not found: unexpected case.
+        assert(false);
+      }
 
-      m_completed_tasks_list.push_back(async_task); // exception
+      if (m_error == nullptr && error != nullptr)
+      {
+        m_error = error;
+      }
     }
-    else
+    catch (bad_alloc& error)
     {
-      // Task with given ID not found: unexpected case.
-      assert(false);
-    }
+      shared_ptr<exception> bad_alloc_error = make_shared<bad_alloc>(error); // exception
 
-    if (m_error == nullptr && error != nullptr)
-    {
-      m_error = error;
+      m_error = bad_alloc_error;
     }
   }
-  catch (bad_alloc& error)
-  {
-    shared_ptr<exception> bad_alloc_error = make_shared<bad_alloc>(error); // exception
 
-    m_error = bad_alloc_error;
-  }
+  // Join completed tasks (which can be joined) and remove them. 
+  // Otherwise deleting of completed tasks causes error!
+  _join_tasks(tasks_to_join); // exception
 
   // Check if all tasks are completed and signal to waiting thread.
   _check_completion_condition();
@@ -113,40 +121,44 @@ bool Async_tasks_manager::are_all_tasks_completed()
 
 void Async_tasks_manager::wait_for_all_tasks_completion()
 {
-  unique_lock<mutex> lock(m_completion_condition_mutex);
+  {
+    unique_lock<mutex> lock(m_completion_condition_mutex);
+
+    while (!are_all_tasks_completed())
+    {
+      m_completion_condition_variable.wait(lock);
+    }
+  }
+
+  // Join threads of the last completed tasks: otherwise they are never released.
+  list<shared_ptr<Async_task>> tasks_to_join;
 
-  while (!are_all_tasks_completed())
   {
-    m_completion_condition_variable.wait(lock);
+    lock_guard<mutex> lock(m_common_mutex);
+
+    tasks_to_join.splice(tasks_to_join.end(), m_completed_tasks_list);
   }
+
+  _join_tasks(tasks_to_join); // exception
 }
 
-void Async_tasks_manager::_join_and_remove_completed_tasks_which_can_be_joined()
+void Async_tasks_manager::_join_tasks(list<shared_ptr<Async_task>>& tasks)
 {
-  // Join threads of completed tasks (which can be joined) and remove them. 
-  // Otherwise deleting of completed tasks causes error!
-  for (auto iterator = m_completed_tasks_list.begin(); iterator != m_completed_tasks_list.end();)
+  for (auto iterator = tasks.begin(); iterator != tasks.end(); iterator = tasks.erase(iterator))
   {
     if ((*iterator)->get_thread().joinable())
     {
       (*iterator)->get_thread().join(); // exception 
-
-      iterator = m_completed_tasks_list.erase(iterator);
-    }
-    else
-    {
-      iterator++;
     }
   } // for
 }
 
 void Async_tasks_manager::_check_completion_condition()
 {
+  // Mutexes are locked in the same order as in wait_for_all_tasks_completion().
   unique_lock<mutex> lock(m_completion_condition_mutex);
 
-  bool all_tasks_completed = (m_active_tasks_map.size() == 0);
-
-  if (all_tasks_completed)
+  if (are_all_tasks_completed())
   {
     m_completion_condition_variable.notify_all();
   }  
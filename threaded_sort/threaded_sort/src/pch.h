@@ -8,22 +8,76 @@
 #define PCH_H_3649401B_54DF_4902_B7FD_B96319AAF96A
 
 #include <stdint.h>
+#include <cstddef>
+#include <cassert>
+#include <stdexcept>
+#include <algorithm>
 #include <vector>
+#include <array>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include <functional>
 #include <list>
 #include <atomic>
 #include <memory>
+#include <new>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <map>
 #include <system_error>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <chrono>
+#include <typeinfo>
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#endif
 
 #include "threaded_sort/async_task.h"
 #include "threaded_sort/async_tasks_manager.h"
+#include "threaded_sort/sort_parameters.h"
+#include "threaded_sort/tuning_profile.h"
+#include "threaded_sort/thread_placement.h"
+#include "threaded_sort/shared_memory_region.h"
+#include "threaded_sort/sort_workspace.h"
+#include "threaded_sort/sorting_network.h"
 #include "threaded_sort/sort_async_task.h"
+#include "threaded_sort/segments_sort_async_task.h"
+#include "threaded_sort/element_pointer.h"
+#include "threaded_sort/permute_async_task.h"
+#include "threaded_sort/string_entry.h"
+#include "threaded_sort/string_sort_async_task.h"
+#include "threaded_sort/natural_run.h"
+#include "threaded_sort/run_scan_async_task.h"
+#include "threaded_sort/run_merge_async_task.h"
+#include "threaded_sort/multiway_merge_async_task.h"
+#include "threaded_sort/batch_merge_async_task.h"
+#include "threaded_sort/reduce_async_task.h"
+#include "threaded_sort/shard_scatter_async_task.h"
+#include "threaded_sort/key_entry.h"
+#include "threaded_sort/key_extract_async_task.h"
 #include "threaded_sort/threaded_sort.h"
+#include "threaded_sort/sort_tuner.h"
 
 // Debug info.
+#ifdef _WIN32
 #include <Windows.h>
 #include <iostream>
 #include <sstream>
@@ -34,5 +88,6 @@ do { \
    os_ << s; \
    OutputDebugStringW( os_.str().c_str() ); \
 } while(false)
+#endif // _WIN32
 
 #endif // PCH_H_3649401B_54DF_4902_B7FD_B96319AAF96A
\ No newline at end of file
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file shared_memory_region.cpp
+/// @brief Implementation of the Shared_memory_region class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+
+namespace My_cpp_libs
+{
+
+using namespace std;
+
+#ifdef __linux__
+
+// Count of regions created by process: makes names of shared memory objects unique.
+static atomic<uint32_t> s_regions_count(0);
+
+#endif // __linux__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Shared_memory_region class members.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Shared_memory_region::Shared_memory_region(size_t size) :
+  m_data(nullptr),
+  m_size(size)
+{
+  if (size == 0)
+  {
+    throw invalid_argument("size");
+  }
+
+#ifdef __linux__
+  const string name = "/threaded_sort_" + to_string(getpid()) + "_" + to_string(s_regions_count++); // exception
+
+  const int descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+
+  if (descriptor < 0)
+  {
+    throw system_error(errno, system_category(), "shm_open");
+  }
+
+  // Name is not needed after mapping: object is removed when region is unmapped by all processes.
+  shm_unlink(name.c_str());
+
+  void* data = MAP_FAILED;
+
+  if (ftruncate(descriptor, static_cast<off_t>(size)) == 0)
+  {
+    data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+  }
+
+  const int error = errno;
+
+  close(descriptor);
+
+  if (data == MAP_FAILED)
+  {
+    throw system_error(error, system_category(), "mmap");
+  }
+
+  m_data = data;
+#else
+  throw system_error(make_error_code(errc::function_not_supported), "shm_open");
+#endif
+}
+
+Shared_memory_region::~Shared_memory_region()
+{
+#ifdef __linux__
+  munmap(m_data, m_size);
+#endif
+}
+
+void* Shared_memory_region::get_data() const
+{
+  return m_data;
+}
+
+size_t Shared_memory_region::get_size() const
+{
+  return m_size;
+}
+
+bool Shared_memory_region::is_supported()
+{
+#ifdef __linux__
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // My_cpp_libs
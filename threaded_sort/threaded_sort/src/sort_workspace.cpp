@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file sort_workspace.cpp
+/// @brief Implementation of the Sort_workspace class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+
+namespace My_cpp_libs
+{
+
+using namespace std;
+
+#ifdef __linux__
+
+// Size of huge page used to round size of mapped block.
+static const size_t s_huge_page_size = 2 * 1024 * 1024;
+
+#endif // __linux__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Sort_workspace class members.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const size_t Sort_workspace::s_default_alignment;
+
+Sort_workspace::Sort_workspace(size_t capacity, size_t alignment, bool is_huge_pages_used) :
+  m_block(nullptr),
+  m_capacity(0),
+  m_used_size(0),
+  m_alignment(max(alignment, alignof(max_align_t))),
+  m_is_huge_pages_used(is_huge_pages_used),
+  m_is_block_mapped(false),
+  m_blocks_count(0)
+{
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+  {
+    throw invalid_argument("alignment");
+  }
+
+  reserve(capacity); // exception
+}
+
+Sort_workspace::~Sort_workspace()
+{
+  _free_block();
+}
+
+void Sort_workspace::reserve(size_t capacity)
+{
+  if (capacity <= m_capacity || m_used_size > 0)
+  {
+    return;
+  }
+
+  char* block = nullptr;
+  bool is_block_mapped = false;
+
+#ifdef __linux__
+  // Mapped memory is aligned to huge page (explicit huge pages) or to page (transparent huge pages): larger
+  // alignment is not supported by mmap.
+  if (m_is_huge_pages_used && m_alignment <= s_huge_page_size)
+  {
+    const size_t mapped_capacity = (capacity + s_huge_page_size - 1) / s_huge_page_size * s_huge_page_size;
+
+    void* memory = mmap(nullptr, mapped_capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+      -1, 0);
+
+    if (memory == MAP_FAILED && m_alignment <= static_cast<size_t>(sysconf(_SC_PAGESIZE)))
+    {
+      // Explicit huge pages are not configured: transparent huge pages are requested.
+      memory = mmap(nullptr, mapped_capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+      if (memory != MAP_FAILED)
+      {
+        madvise(memory, mapped_capacity, MADV_HUGEPAGE);
+      }
+    }
+
+    if (memory != MAP_FAILED)
+    {
+      block = static_cast<char*>(memory);
+      capacity = mapped_capacity;
+      is_block_mapped = true;
+    }
+  }
+#endif
+
+  if (block == nullptr)
+  {
+    block = static_cast<char*>(::operator new(capacity, align_val_t(m_alignment))); // exception
+  }
+
+  _free_block();
+
+  m_block = block;
+  m_capacity = capacity;
+  m_is_block_mapped = is_block_mapped;
+  m_blocks_count++;
+}
+
+size_t Sort_workspace::get_capacity() const
+{
+  return m_capacity;
+}
+
+size_t Sort_workspace::get_used_size() const
+{
+  return m_used_size;
+}
+
+size_t Sort_workspace::get_alignment() const
+{
+  return m_alignment;
+}
+
+bool Sort_workspace::is_huge_pages_used() const
+{
+  return m_is_huge_pages_used;
+}
+
+int32_t Sort_workspace::get_blocks_count() const
+{
+  return m_blocks_count;
+}
+
+void* Sort_workspace::allocate(size_t size, size_t alignment)
+{
+  assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+  alignment = max(alignment, m_alignment);
+
+  // Address is aligned: alignment of buffer may be greater than alignment of block.
+  const uintptr_t address = reinterpret_cast<uintptr_t>(m_block) + m_used_size;
+
+  const size_t first = m_used_size + (alignment - address % alignment) % alignment;
+
+  if (first > m_capacity || size > m_capacity - first)
+  {
+    return nullptr;
+  }
+
+  m_used_size = first + size;
+
+  return (m_block + first);
+}
+
+bool Sort_workspace::is_owner(const void* pointer) const
+{
+  const char* address = static_cast<const char*>(pointer);
+
+  return (m_block != nullptr && address >= m_block && address < m_block + m_capacity);
+}
+
+void Sort_workspace::_release(size_t used_size)
+{
+  assert(used_size <= m_used_size);
+
+  m_used_size = used_size;
+}
+
+void Sort_workspace::_free_block()
+{
+  if (m_block == nullptr)
+  {
+    return;
+  }
+
+#ifdef __linux__
+  if (m_is_block_mapped)
+  {
+    munmap(m_block, m_capacity);
+  }
+  else
+#endif
+  {
+    ::operator delete(m_block, align_val_t(m_alignment));
+  }
+
+  m_block = nullptr;
+  m_capacity = 0;
+}
+
+} // My_cpp_libs
@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file string_sort_async_task.cpp
+/// @brief Implementation of the String_sort_async_task class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+
+namespace My_cpp_libs
+{
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// String_sort_async_task class members.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+String_sort_async_task::String_sort_async_task(Workspace_vector<String_entry>& entries, int32_t left, int32_t right,
+  size_t depth, const Sort_parameters& parameters, shared_ptr<Async_tasks_manager> tasks_manager) :
+    m_entries(entries),
+    m_left(left),
+    m_right(right),
+    m_depth(depth),
+    m_parameters(parameters),
+    m_tasks_manager(tasks_manager),
+    m_recursion_level(0)
+{
+  assert(left >= 0 && left < right && right <= static_cast<int32_t>(entries.size()));
+  assert(parameters.is_valid());
+  assert(tasks_manager != nullptr);
+}
+
+String_sort_async_task::~String_sort_async_task()
+{
+}
+
+void String_sort_async_task::_do_in_background()
+{
+  bool is_result_ok = true;
+
+  try
+  {
+    _multikey_quick_sort(m_left, m_right, m_depth); // exception
+  }
+  catch (exception& error)
+  {
+    shared_ptr<exception> error_ptr = make_shared<exception>(error);
+
+    _on_error(error_ptr);
+
+    is_result_ok = false;
+  }
+
+  if (is_result_ok)
+  {
+    m_tasks_manager->handle_task_completion(get_task_id(), nullptr);
+
+    _set_status(Status::completed);
+  }
+}
+
+void String_sort_async_task::_on_error(const shared_ptr<exception>& error)
+{
+  assert(error != nullptr);
+
+  Async_task::_on_error(error);
+
+  m_tasks_manager->handle_task_completion(get_task_id(), error);
+}
+
+void String_sort_async_task::_start_new_sort_async_task(int32_t left, int32_t right, size_t depth)
+{
+  shared_ptr<Async_task> sort_async_task = make_shared<String_sort_async_task>(m_entries, left, right, depth,
+    m_parameters, m_tasks_manager); // exception
+
+  m_tasks_manager->add_task(sort_async_task); // exception
+
+  sort_async_task->execute(); // exception
+}
+
+void String_sort_async_task::_sort_or_start_new_task(int32_t left, int32_t right, size_t depth)
+{
+  if (right - left < 2)
+  {
+    return;
+  }
+
+  if (!_should_start_new_task(left, right))
+  {
+    _multikey_quick_sort(left, right, depth); // exception
+  }
+  else
+  {
+    _start_new_sort_async_task(left, right, depth); // exception
+  }
+}
+
+void String_sort_async_task::_multikey_quick_sort(int32_t left, int32_t right, size_t depth)
+{
+  Auto_incrementer recursion_level_incrementer(m_recursion_level);
+
+  // Equal part is sorted in loop: long common prefixes don't increase recursion.
+  while (right - left > 1)
+  {
+    if (m_tasks_manager->is_error_occurred())
+    {
+      return;
+    }
+
+    if (right - left <= m_parameters.insertion_sort_threshold)
+    {
+      _insertion_sort(left, right, depth);
+
+      return;
+    }
+
+    // Median of three caches.
+    uint64_t first = m_entries[left].cache;
+    uint64_t middle = m_entries[left + (right - left) / 2].cache;
+    uint64_t last = m_entries[right - 1].cache;
+
+    if (middle < first) swap(first, middle);
+    if (last < middle) swap(middle, last);
+    if (middle < first) swap(first, middle);
+
+    const uint64_t pivot = middle;
+
+    // Three-way partition: [left, less) < pivot, [less, greater) == pivot, [greater, right) > pivot.
+    // Two bidirectional (Hoare) passes don't move elements of sorted ranges.
+    const Workspace_vector<String_entry>::iterator first_entry = m_entries.begin();
+
+    const int32_t less = static_cast<int32_t>(partition(first_entry + left, first_entry + right,
+      [pivot](const String_entry& entry) { return (entry.cache < pivot); }) - first_entry);
+
+    const int32_t greater = static_cast<int32_t>(partition(first_entry + less, first_entry + right,
+      [pivot](const String_entry& entry) { return (entry.cache == pivot); }) - first_entry);
+
+    _sort_or_start_new_task(left, less, depth); // exception
+    _sort_or_start_new_task(greater, right, depth); // exception
+
+    // Strings of equal part which are finished in cache are prefixes of others: they go first by length.
+    int32_t unfinished = less;
+
+    for (int32_t k = less; k < greater; k++)
+    {
+      if (m_entries[k].is_finished(depth))
+      {
+        swap(m_entries[unfinished++], m_entries[k]);
+      }
+    }
+
+    sort(m_entries.begin() + less, m_entries.begin() + unfinished,
+      [](const String_entry& left_entry, const String_entry& right_entry)
+      {
+        return (left_entry.length < right_entry.length);
+      });
+
+    // Other strings share cached characters: sort them at the next depth.
+    left = unfinished;
+    right = greater;
+    depth += String_entry::s_cache_size;
+
+    for (int32_t k = left; k < right; k++)
+    {
+      m_entries[k].load_cache(depth);
+    }
+  }
+}
+
+void String_sort_async_task::_insertion_sort(int32_t left, int32_t right, size_t depth)
+{
+  const size_t offset = depth + String_entry::s_cache_size;
+
+  auto is_less = [offset](const String_entry& left_entry, const String_entry& right_entry)
+  {
+    if (left_entry.cache != right_entry.cache)
+    {
+      return (left_entry.cache < right_entry.cache);
+    }
+
+    // Equal caches: finished string is prefix of other one.
+    if (left_entry.length <= offset || right_entry.length <= offset)
+    {
+      return (left_entry.length < right_entry.length);
+    }
+
+    const int compare_result = char_traits<char>::compare(left_entry.characters + offset,
+      right_entry.characters + offset, min(left_entry.length, right_entry.length) - offset);
+
+    return (compare_result < 0 || (compare_result == 0 && left_entry.length < right_entry.length));
+  };
+
+  for (int32_t i = left + 1; i < right; i++)
+  {
+    if (!is_less(m_entries[i], m_entries[i - 1]))
+    {
+      continue;
+    }
+
+    const String_entry entry = m_entries[i];
+
+    int32_t j = i;
+
+    do
+    {
+      m_entries[j] = m_entries[j - 1];
+      j--;
+    } while (j > left && is_less(entry, m_entries[j - 1]));
+
+    m_entries[j] = entry;
+  }
+}
+
+bool String_sort_async_task::_should_start_new_task(int32_t left, int32_t right) const
+{
+  return (m_recursion_level > m_parameters.max_recursion_depth && right - left >= m_parameters.min_task_size);
+}
+
+} // My_cpp_libs
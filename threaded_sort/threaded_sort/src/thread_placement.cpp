@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file thread_placement.cpp
+/// @brief Implementation of the Thread_placement class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+
+namespace My_cpp_libs
+{
+
+using namespace std;
+
+#ifdef __linux__
+
+// Flags of get_mempolicy system call (numaif.h is not required).
+#ifndef MPOL_F_NODE
+#define MPOL_F_NODE (1 << 0)
+#endif
+
+#ifndef MPOL_F_ADDR
+#define MPOL_F_ADDR (1 << 1)
+#endif
+
+#endif // __linux__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Thread_placement class members.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Thread_placement::Thread_placement() :
+  m_cpus(get_available_cpus()), // exception
+  m_is_numa_aware(true)
+{
+  _init_node_cpus(); // exception
+}
+
+Thread_placement::Thread_placement(const vector<int32_t>& cpus, bool is_numa_aware) :
+  m_cpus(cpus), // exception
+  m_is_numa_aware(is_numa_aware)
+{
+  sort(m_cpus.begin(), m_cpus.end());
+
+  m_cpus.erase(unique(m_cpus.begin(), m_cpus.end()), m_cpus.end());
+
+  const vector<int32_t> available_cpus = get_available_cpus(); // exception
+
+  if (m_cpus.empty() || !includes(available_cpus.begin(), available_cpus.end(), m_cpus.begin(), m_cpus.end()))
+  {
+    throw invalid_argument("cpus");
+  }
+
+  _init_node_cpus(); // exception
+}
+
+Thread_placement::~Thread_placement()
+{
+
+}
+
+vector<int32_t> Thread_placement::get_available_cpus()
+{
+  vector<int32_t> cpus;
+
+#ifdef __linux__
+  // Affinity of calling thread may be narrowed (e.g. pinned sort thread): CPUs of process are read from its status.
+  ifstream status_file("/proc/self/status");
+
+  string line;
+
+  while (status_file && getline(status_file, line)) // exception
+  {
+    if (line.compare(0, 18, "Cpus_allowed_list:") == 0)
+    {
+      cpus = _parse_list(line.substr(18)); // exception
+
+      break;
+    }
+  }
+
+  cpu_set_t cpu_set;
+
+  // Status is not available: affinity of main thread (its identifier is identifier of process) is used.
+  if (cpus.empty() && sched_getaffinity(getpid(), sizeof(cpu_set), &cpu_set) == 0)
+  {
+    for (int32_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+      if (CPU_ISSET(cpu, &cpu_set))
+      {
+        cpus.push_back(cpu); // exception
+      }
+    }
+  }
+#endif
+
+  if (cpus.empty())
+  {
+    const int32_t cpus_count = max<int32_t>(static_cast<int32_t>(thread::hardware_concurrency()), 1);
+
+    for (int32_t cpu = 0; cpu < cpus_count; cpu++)
+    {
+      cpus.push_back(cpu); // exception
+    }
+  }
+
+  return cpus;
+}
+
+const vector<int32_t>& Thread_placement::get_cpus() const
+{
+  return m_cpus;
+}
+
+bool Thread_placement::is_numa_aware() const
+{
+  return m_is_numa_aware;
+}
+
+int32_t Thread_placement::get_numa_nodes_count() const
+{
+  return static_cast<int32_t>(m_node_cpus.size());
+}
+
+const vector<int32_t>& Thread_placement::get_node_cpus(int32_t node) const
+{
+  assert(node >= 0 && node < get_numa_nodes_count());
+
+  return m_node_cpus[node];
+}
+
+int32_t Thread_placement::get_memory_node(const void* address) const
+{
+  if (m_node_cpus.size() < 2)
+  {
+    return 0;
+  }
+
+#ifdef __linux__
+  int node = -1;
+
+  if (syscall(SYS_get_mempolicy, &node, nullptr, 0UL, address, MPOL_F_NODE | MPOL_F_ADDR) == 0 &&
+    node >= 0 && node < get_numa_nodes_count())
+  {
+    return node;
+  }
+#endif
+
+  return 0;
+}
+
+bool Thread_placement::apply_to_current_thread(const void* address) const
+{
+#ifdef __linux__
+  const vector<int32_t>* cpus = &m_cpus;
+
+  if (m_is_numa_aware && m_node_cpus.size() > 1)
+  {
+    const vector<int32_t>& node_cpus = m_node_cpus[get_memory_node(address)];
+
+    if (!node_cpus.empty())
+    {
+      cpus = &node_cpus;
+    }
+  }
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+
+  for (int32_t cpu : *cpus)
+  {
+    if (cpu < CPU_SETSIZE)
+    {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+
+  return (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0);
+#else
+  return false;
+#endif
+}
+
+void Thread_placement::_init_node_cpus()
+{
+  m_node_cpus.clear();
+
+#ifdef __linux__
+  ifstream online_file("/sys/devices/system/node/online");
+
+  string online_list;
+
+  if (online_file && getline(online_file, online_list))
+  {
+    const vector<int32_t> nodes = _parse_list(online_list); // exception
+
+    if (!nodes.empty())
+    {
+      m_node_cpus.resize(nodes.back() + 1); // exception
+    }
+
+    for (int32_t node : nodes)
+    {
+      ifstream cpu_list_file("/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+
+      string cpu_list;
+
+      if (!cpu_list_file || !getline(cpu_list_file, cpu_list))
+      {
+        continue;
+      }
+
+      for (int32_t cpu : _parse_list(cpu_list)) // exception
+      {
+        if (binary_search(m_cpus.begin(), m_cpus.end(), cpu))
+        {
+          m_node_cpus[node].push_back(cpu); // exception
+        }
+      }
+    }
+  }
+#endif
+
+  // NUMA topology is not available: all CPUs are on single node.
+  if (m_node_cpus.size() < 2)
+  {
+    m_node_cpus.assign(1, m_cpus); // exception
+  }
+}
+
+vector<int32_t> Thread_placement::_parse_list(const string& list)
+{
+  vector<int32_t> values;
+
+  istringstream list_stream(list);
+
+  string item;
+
+  while (getline(list_stream, item, ',')) // exception
+  {
+    int32_t first = 0;
+    int32_t last = 0;
+
+    const int fields_count = sscanf(item.c_str(), "%d-%d", &first, &last);
+
+    if (fields_count < 1 || first < 0)
+    {
+      continue;
+    }
+
+    if (fields_count < 2)
+    {
+      last = first;
+    }
+
+    for (int32_t value = first; value <= last; value++)
+    {
+      values.push_back(value); // exception
+    }
+  }
+
+  return values;
+}
+
+} // My_cpp_libs
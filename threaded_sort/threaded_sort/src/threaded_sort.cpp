@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file threaded_sort.cpp
+/// @brief Implementation of the Threaded_sort class (non-template members).
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+
+namespace My_cpp_libs
+{
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Threaded_sort class members.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char* const Threaded_sort::s_tuning_profile_environment_variable = "THREADED_SORT_TUNING_PROFILE";
+
+mutex Threaded_sort::s_tuning_profile_mutex;
+
+Tuning_profile Threaded_sort::s_tuning_profile;
+
+bool Threaded_sort::s_is_tuning_profile_loaded = false;
+
+atomic<int32_t> Threaded_sort::s_workers_count(0);
+
+void Threaded_sort::set_workers_count(int32_t workers_count)
+{
+  if (workers_count < 0)
+  {
+    throw invalid_argument("workers_count");
+  }
+
+  s_workers_count = workers_count;
+}
+
+int32_t Threaded_sort::get_workers_count()
+{
+  const int32_t workers_count = s_workers_count;
+
+  if (workers_count > 0)
+  {
+    return workers_count;
+  }
+
+  return max<int32_t>(static_cast<int32_t>(thread::hardware_concurrency()), 1);
+}
+
+void Threaded_sort::set_tuning_profile(const Tuning_profile& profile)
+{
+  lock_guard<mutex> lock(s_tuning_profile_mutex);
+
+  s_tuning_profile = profile; // exception
+
+  s_is_tuning_profile_loaded = true;
+}
+
+Tuning_profile Threaded_sort::get_tuning_profile()
+{
+  lock_guard<mutex> lock(s_tuning_profile_mutex);
+
+  _load_tuning_profile_once();
+
+  return s_tuning_profile; // exception
+}
+
+void Threaded_sort::_wait_for_all_tasks_completion(const shared_ptr<Async_tasks_manager>& tasks_manager)
+{
+  assert(tasks_manager != nullptr);
+
+  // Wait while all asynchronous sort tasks are completed.
+  tasks_manager->wait_for_all_tasks_completion(); // exception
+
+  // Get execution error.
+  shared_ptr<exception> execution_error = tasks_manager->get_error();
+
+  // Throw error if it occurred on execution.
+  if (execution_error != nullptr)
+  {
+    throw exception(*execution_error);
+  }
+}
+
+int32_t Threaded_sort::_get_chunks_count(int64_t size, const Sort_parameters& parameters)
+{
+  // Small amount of work is done faster without threads.
+  if (size < parameters.sequential_sort_threshold)
+  {
+    return 1;
+  }
+
+  return static_cast<int32_t>(max<int64_t>(min<int64_t>(get_workers_count(), size / parameters.min_task_size), 1));
+}
+
+void Threaded_sort::_plan_run_merges(const vector<int32_t>& range_starts, vector<vector<Run_merge_job>>& levels)
+{
+  assert(range_starts.size() >= 3);
+
+  const int32_t ranges_count = static_cast<int32_t>(range_starts.size()) - 1;
+
+  // Node k of merge tree merges ranges around boundary between range k and range k + 1.
+  const int32_t nodes_count = ranges_count - 1;
+
+  vector<int32_t> powers(nodes_count); // exception
+
+  for (int32_t node = 0; node < nodes_count; node++)
+  {
+    powers[node] = _get_merge_power(range_starts[node], range_starts[node + 1] - range_starts[node],
+      range_starts[node + 2] - range_starts[node + 1], range_starts[ranges_count]);
+  }
+
+  // Cartesian tree by powers (the smallest power is root, the leftmost one among equal powers).
+  vector<int32_t> left_children(nodes_count, -1); // exception
+  vector<int32_t> right_children(nodes_count, -1); // exception
+  vector<int32_t> stack;
+
+  stack.reserve(nodes_count); // exception
+
+  for (int32_t node = 0; node < nodes_count; node++)
+  {
+    int32_t last_popped_node = -1;
+
+    while (!stack.empty() && powers[stack.back()] > powers[node])
+    {
+      last_popped_node = stack.back();
+
+      stack.pop_back();
+    }
+
+    left_children[node] = last_popped_node;
+
+    if (!stack.empty())
+    {
+      right_children[stack.back()] = node;
+    }
+
+    stack.push_back(node);
+  }
+
+  // Height of node is level of merge: children are merged on lower levels. Nodes are visited in post-order.
+  vector<int32_t> heights(nodes_count, 0); // exception
+  vector<int32_t> first_ranges(nodes_count); // exception
+  vector<int32_t> last_ranges(nodes_count); // exception
+
+  const int32_t root = stack.front();
+
+  stack.clear();
+
+  int32_t node = root;
+  int32_t last_visited_node = -1;
+
+  while (node >= 0 || !stack.empty())
+  {
+    if (node >= 0)
+    {
+      stack.push_back(node);
+
+      node = left_children[node];
+
+      continue;
+    }
+
+    const int32_t top = stack.back();
+
+    if (right_children[top] >= 0 && right_children[top] != last_visited_node)
+    {
+      node = right_children[top];
+
+      continue;
+    }
+
+    const int32_t left = left_children[top];
+    const int32_t right = right_children[top];
+
+    first_ranges[top] = (left >= 0) ? first_ranges[left] : top;
+    last_ranges[top] = (right >= 0) ? last_ranges[right] : top + 1;
+
+    heights[top] = 1 + max((left >= 0) ? heights[left] : 0, (right >= 0) ? heights[right] : 0);
+
+    if (static_cast<int32_t>(levels.size()) < heights[top])
+    {
+      levels.resize(heights[top]); // exception
+    }
+
+    levels[heights[top] - 1].push_back({ Run_merge_job::Operation::merge, range_starts[first_ranges[top]],
+      range_starts[top + 1], range_starts[last_ranges[top] + 1] }); // exception
+
+    last_visited_node = top;
+
+    stack.pop_back();
+  }
+}
+
+int32_t Threaded_sort::_get_merge_power(int64_t first, int64_t left_size, int64_t right_size, int64_t size)
+{
+  assert(left_size > 0 && right_size > 0 && first + left_size + right_size <= size);
+
+  // Doubled middles of ranges are compared with halves of vector until they are split.
+  int64_t left_middle = 2 * first + left_size;
+  int64_t right_middle = left_middle + left_size + right_size;
+
+  int32_t power = 0;
+
+  while (true)
+  {
+    power++;
+
+    if (left_middle >= size)
+    {
+      left_middle -= size;
+      right_middle -= size;
+    }
+    else if (right_middle >= size)
+    {
+      break;
+    }
+
+    left_middle <<= 1;
+    right_middle <<= 1;
+  }
+
+  return power;
+}
+
+int32_t Threaded_sort::_start_worker_process(const function<void()>& work)
+{
+#ifdef __linux__
+  const pid_t process_id = fork();
+
+  if (process_id < 0)
+  {
+    throw system_error(errno, system_category(), "fork");
+  }
+
+  if (process_id == 0)
+  {
+    int status = 0;
+
+    try
+    {
+      work(); // exception
+    }
+    catch (...)
+    {
+      status = 1;
+    }
+
+    // Worker process doesn't run destructors of static objects and exit handlers of calling process.
+    _exit(status);
+  }
+
+  return static_cast<int32_t>(process_id);
+#else
+  (void)work;
+
+  throw system_error(make_error_code(errc::function_not_supported), "fork");
+#endif
+}
+
+bool Threaded_sort::_wait_for_worker_processes(const vector<int32_t>& process_ids)
+{
+  bool is_result_ok = true;
+
+#ifdef __linux__
+  for (int32_t process_id : process_ids)
+  {
+    int status = 0;
+
+    pid_t result = 0;
+
+    do
+    {
+      result = waitpid(static_cast<pid_t>(process_id), &status, 0);
+    } while (result < 0 && errno == EINTR);
+
+    if (result < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+      is_result_ok = false;
+    }
+  }
+#else
+  is_result_ok = process_ids.empty();
+#endif
+
+  return is_result_ok;
+}
+
+void Threaded_sort::_load_tuning_profile_once()
+{
+  if (s_is_tuning_profile_loaded)
+  {
+    return;
+  }
+
+  s_is_tuning_profile_loaded = true;
+
+  const char* file_path = getenv(s_tuning_profile_environment_variable);
+
+  if (file_path == nullptr || *file_path == '\0')
+  {
+    return;
+  }
+
+  try
+  {
+    s_tuning_profile.load(file_path); // exception
+  }
+  catch (exception&)
+  {
+    // Profile is optional: default parameters are used if it can't be loaded.
+  }
+}
+
+} // My_cpp_libs
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file tuning_profile.cpp
+/// @brief Implementation of the Tuning_profile class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+
+namespace My_cpp_libs
+{
+
+using namespace std;
+
+// Version of profile format: version 1 (without version line) has no indirect_sort_element_size and
+// adaptive_run_length, they get default values.
+static const int32_t s_format_version = 2;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Tuning_profile class members.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Tuning_profile::Tuning_profile()
+{
+
+}
+
+Tuning_profile::~Tuning_profile()
+{
+
+}
+
+bool Tuning_profile::is_empty() const
+{
+  return m_entries.empty();
+}
+
+void Tuning_profile::set_parameters(const string& type_name, int32_t element_size, const Sort_parameters& parameters)
+{
+  if (type_name.empty() || type_name.find_first_of("\r\n") != string::npos)
+  {
+    throw invalid_argument("type_name");
+  }
+
+  if (element_size <= 0)
+  {
+    throw invalid_argument("element_size");
+  }
+
+  if (!parameters.is_valid())
+  {
+    throw invalid_argument("parameters");
+  }
+
+  for (Entry& entry : m_entries)
+  {
+    if (entry.type_name == type_name)
+    {
+      entry.element_size = element_size;
+      entry.parameters = parameters;
+
+      return;
+    }
+  }
+
+  Entry entry = { type_name, element_size, parameters }; // exception
+
+  m_entries.push_back(entry); // exception
+}
+
+Sort_parameters Tuning_profile::get_parameters(const string& type_name, int32_t element_size) const
+{
+  const Entry* nearest_entry = nullptr;
+
+  for (const Entry& entry : m_entries)
+  {
+    if (entry.type_name == type_name)
+    {
+      return entry.parameters;
+    }
+
+    if (nearest_entry == nullptr ||
+      abs(entry.element_size - element_size) < abs(nearest_entry->element_size - element_size))
+    {
+      nearest_entry = &entry;
+    }
+  }
+
+  return (nearest_entry != nullptr) ? nearest_entry->parameters : Sort_parameters();
+}
+
+void Tuning_profile::load(const string& file_path)
+{
+  ifstream file(file_path);
+
+  if (!file)
+  {
+    throw runtime_error("Can't open tuning profile: " + file_path);
+  }
+
+  Tuning_profile profile;
+
+  int32_t format_version = 1;
+
+  string line;
+
+  while (getline(file, line)) // exception
+  {
+    if (line.empty() || line[0] == '#')
+    {
+      continue;
+    }
+
+    istringstream line_stream(line);
+
+    if (line.compare(0, 8, "version ") == 0)
+    {
+      string keyword;
+
+      line_stream >> keyword >> format_version;
+
+      if (line_stream.fail() || format_version < 1 || format_version > s_format_version)
+      {
+        throw runtime_error("Unsupported version of tuning profile: " + file_path);
+      }
+
+      continue;
+    }
+
+    int32_t element_size = 0;
+    Sort_parameters parameters;
+    string type_name;
+
+    line_stream >> element_size >> parameters.max_recursion_depth >> parameters.min_task_size >>
+      parameters.insertion_sort_threshold >> parameters.sequential_sort_threshold;
+
+    if (format_version >= 2)
+    {
+      line_stream >> parameters.indirect_sort_element_size >> parameters.adaptive_run_length;
+    }
+
+    // Type name is the rest of line: it may contain spaces.
+    getline(line_stream >> ws, type_name);
+
+    if (line_stream.fail() || element_size <= 0 || type_name.empty() || !parameters.is_valid())
+    {
+      throw runtime_error("Invalid format of tuning profile: " + file_path);
+    }
+
+    profile.set_parameters(type_name, element_size, parameters); // exception
+  }
+
+  if (file.bad())
+  {
+    throw runtime_error("Can't read tuning profile: " + file_path);
+  }
+
+  m_entries.swap(profile.m_entries);
+}
+
+void Tuning_profile::save(const string& file_path) const
+{
+  ofstream file(file_path);
+
+  if (!file)
+  {
+    throw runtime_error("Can't create tuning profile: " + file_path);
+  }
+
+  file << "# threaded_sort tuning profile (hardware concurrency: " << thread::hardware_concurrency() << ")\n";
+  file << "version " << s_format_version << '\n';
+  file << "# element_size max_recursion_depth min_task_size insertion_sort_threshold sequential_sort_threshold "
+    "indirect_sort_element_size adaptive_run_length type\n";
+
+  for (const Entry& entry : m_entries)
+  {
+    file << entry.element_size << ' ' << entry.parameters.max_recursion_depth << ' ' <<
+      entry.parameters.min_task_size << ' ' << entry.parameters.insertion_sort_threshold << ' ' <<
+      entry.parameters.sequential_sort_threshold << ' ' << entry.parameters.indirect_sort_element_size << ' ' <<
+      entry.parameters.adaptive_run_length << ' ' << entry.type_name << '\n';
+  }
+
+  file.flush();
+
+  if (!file)
+  {
+    throw runtime_error("Can't write tuning profile: " + file_path);
+  }
+}
+
+} // My_cpp_libs
@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file benchmark_data.h
+/// @brief Input data generators (key distributions and element types) used by benchmarks.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BENCHMARK_DATA_H_0F6A3C1E_52B4_4D9A_8B77_C4E19A3D2F60
+#define BENCHMARK_DATA_H_0F6A3C1E_52B4_4D9A_8B77_C4E19A3D2F60
+
+namespace My_cpp_libs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Distribution of keys in generated input data.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum class Distribution
+{
+  random,        // Uniformly distributed random keys.
+  sorted,        // Keys in ascending order.
+  reverse,       // Keys in descending order.
+  organ_pipe,    // Keys ascend to the middle and then descend.
+  sawtooth,      // Several ascending runs of equal length.
+  nearly_sorted, // Keys in ascending order, 1% of keys are random.
+  few_unique,    // Random keys taking only a few distinct values.
+  zipf           // Random keys with Zipf-like (s = 1) frequencies: small keys are frequent.
+};
+
+/// @brief All distributions in order of declaration.
+static const Distribution s_all_distributions[] =
+{
+  Distribution::random, Distribution::sorted, Distribution::reverse, Distribution::organ_pipe,
+  Distribution::sawtooth, Distribution::nearly_sorted, Distribution::few_unique, Distribution::zipf
+};
+
+/// @brief Gets name of distribution used in benchmark names.
+inline const char* get_distribution_name(Distribution distribution)
+{
+  switch (distribution)
+  {
+  case Distribution::random:        return "random";
+  case Distribution::sorted:        return "sorted";
+  case Distribution::reverse:       return "reverse";
+  case Distribution::organ_pipe:    return "organ_pipe";
+  case Distribution::sawtooth:      return "sawtooth";
+  case Distribution::nearly_sorted: return "nearly_sorted";
+  case Distribution::few_unique:    return "few_unique";
+  case Distribution::zipf:          return "zipf";
+  }
+
+  assert(false);
+
+  return "unknown";
+}
+
+/// @brief Generates keys with given distribution. All keys are in range [0, 2^31).
+/// @param distribution Distribution of keys.
+/// @param size Count of keys.
+/// @param keys Output vector of keys.
+/// @exception std::bad_alloc
+inline void generate_keys(Distribution distribution, size_t size, std::vector<uint64_t>& keys)
+{
+  const uint64_t max_key = 0x7FFFFFFF;
+  const size_t few_unique_count = 16;
+  const size_t sawtooth_teeth_count = 16;
+
+  // Fixed seed: every run of benchmark sorts the same data.
+  std::mt19937_64 generator(20140601);
+  std::uniform_int_distribution<uint64_t> uniform(0, max_key);
+
+  keys.clear();
+
+  keys.resize(size); // exception
+
+  switch (distribution)
+  {
+  case Distribution::random:
+    for (size_t i = 0; i < size; i++)
+    {
+      keys[i] = uniform(generator);
+    }
+    break;
+
+  case Distribution::sorted:
+    for (size_t i = 0; i < size; i++)
+    {
+      keys[i] = i & max_key;
+    }
+    break;
+
+  case Distribution::reverse:
+    for (size_t i = 0; i < size; i++)
+    {
+      keys[i] = (size - i) & max_key;
+    }
+    break;
+
+  case Distribution::organ_pipe:
+    for (size_t i = 0; i < size; i++)
+    {
+      keys[i] = std::min(i, size - 1 - i) & max_key;
+    }
+    break;
+
+  case Distribution::sawtooth:
+    {
+      const size_t tooth_size = std::max<size_t>(size / sawtooth_teeth_count, 1);
+
+      for (size_t i = 0; i < size; i++)
+      {
+        keys[i] = (i % tooth_size) & max_key;
+      }
+    }
+    break;
+
+  case Distribution::nearly_sorted:
+    for (size_t i = 0; i < size; i++)
+    {
+      keys[i] = (generator() % 100 == 0) ? uniform(generator) : (i & max_key);
+    }
+    break;
+
+  case Distribution::few_unique:
+    for (size_t i = 0; i < size; i++)
+    {
+      keys[i] = uniform(generator) % few_unique_count;
+    }
+    break;
+
+  case Distribution::zipf:
+    {
+      // Inverse transform of continuous power law with exponent 1 over [1, size + 1):
+      // probability of key k is proportional to 1 / k.
+      std::uniform_real_distribution<double> unit(0.0, 1.0);
+      const double log_range = std::log(static_cast<double>(size) + 1.0);
+
+      for (size_t i = 0; i < size; i++)
+      {
+        keys[i] = (static_cast<uint64_t>(std::exp(unit(generator) * log_range)) - 1) & max_key;
+      }
+    }
+    break;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct Record_16: 16-byte element compared by key.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Record_16
+{
+  int64_t key;
+  int64_t payload;
+};
+
+inline bool operator<(const Record_16& left, const Record_16& right)
+{
+  return left.key < right.key;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Struct Large_record<Size>: large element (Size bytes) compared by key.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <size_t Size>
+struct Large_record
+{
+  int64_t key;
+  char payload[Size - sizeof(int64_t)];
+};
+
+template <size_t Size>
+inline bool operator<(const Large_record<Size>& left, const Large_record<Size>& right)
+{
+  return left.key < right.key;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Traits of element types used by benchmarks: name and conversion from generated key.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class T>
+struct Element_traits;
+
+template <>
+struct Element_traits<int32_t>
+{
+  static const char* name() { return "int32"; }
+  static int32_t make(uint64_t key) { return static_cast<int32_t>(key); }
+};
+
+template <>
+struct Element_traits<int64_t>
+{
+  static const char* name() { return "int64"; }
+  static int64_t make(uint64_t key) { return static_cast<int64_t>(key); }
+};
+
+template <>
+struct Element_traits<double>
+{
+  static const char* name() { return "double"; }
+  static double make(uint64_t key) { return static_cast<double>(key) * 0.5; }
+};
+
+template <>
+struct Element_traits<Record_16>
+{
+  static const char* name() { return "record16"; }
+  static Record_16 make(uint64_t key) { return Record_16{ static_cast<int64_t>(key), static_cast<int64_t>(~key) }; }
+};
+
+template <>
+struct Element_traits<std::string>
+{
+  static const char* name() { return "string"; }
+
+  // Zero-padded decimal key with common prefix: longer than small string buffer, so it is heap allocated.
+  static std::string make(uint64_t key)
+  {
+    char buffer[32];
+
+    std::snprintf(buffer, sizeof(buffer), "key/%020llu", static_cast<unsigned long long>(key));
+
+    return std::string(buffer); // exception
+  }
+};
+
+/// @brief Generates input vector of elements with given distribution of keys.
+/// @param <T> Type of elements in vector.
+/// @param distribution Distribution of keys.
+/// @param size Count of elements.
+/// @param vector Output vector.
+/// @exception std::bad_alloc
+template <class T>
+void generate_vector(Distribution distribution, size_t size, std::vector<T>& vector)
+{
+  std::vector<uint64_t> keys;
+
+  generate_keys(distribution, size, keys); // exception
+
+  vector.clear();
+
+  vector.reserve(size); // exception
+
+  for (size_t i = 0; i < size; i++)
+  {
+    vector.push_back(Element_traits<T>::make(keys[i])); // exception
+  }
+}
+
+} // My_cpp_libs
+
+#endif // BENCHMARK_DATA_H_0F6A3C1E_52B4_4D9A_8B77_C4E19A3D2F60
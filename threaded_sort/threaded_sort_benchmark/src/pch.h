@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file pch.h
+/// @brief Precompiled Header File.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PCH_H_8E0C55A2_7D1B_4C8E_9F0B_2B1E4D7A6C31
+#define PCH_H_8E0C55A2_7D1B_4C8E_9F0B_2B1E4D7A6C31
+
+#include <stdint.h>
+#include <cstddef>
+#include <cassert>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <array>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include <functional>
+#include <list>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <map>
+#include <system_error>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <chrono>
+#include <typeinfo>
+#include <cstdlib>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(THREADED_SORT_BENCHMARK_HAS_TBB)
+#include <execution>
+#include <tbb/global_control.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "threaded_sort/async_task.h"
+#include "threaded_sort/async_tasks_manager.h"
+#include "threaded_sort/sort_parameters.h"
+#include "threaded_sort/tuning_profile.h"
+#include "threaded_sort/thread_placement.h"
+#include "threaded_sort/shared_memory_region.h"
+#include "threaded_sort/sort_workspace.h"
+#include "threaded_sort/sorting_network.h"
+#include "threaded_sort/sort_async_task.h"
+#include "threaded_sort/segments_sort_async_task.h"
+#include "threaded_sort/element_pointer.h"
+#include "threaded_sort/permute_async_task.h"
+#include "threaded_sort/string_entry.h"
+#include "threaded_sort/string_sort_async_task.h"
+#include "threaded_sort/natural_run.h"
+#include "threaded_sort/run_scan_async_task.h"
+#include "threaded_sort/run_merge_async_task.h"
+#include "threaded_sort/multiway_merge_async_task.h"
+#include "threaded_sort/batch_merge_async_task.h"
+#include "threaded_sort/reduce_async_task.h"
+#include "threaded_sort/shard_scatter_async_task.h"
+#include "threaded_sort/key_entry.h"
+#include "threaded_sort/key_extract_async_task.h"
+#include "threaded_sort/threaded_sort.h"
+#include "threaded_sort/sort_tuner.h"
+
+#include "benchmark/benchmark.h"
+
+#endif // PCH_H_8E0C55A2_7D1B_4C8E_9F0B_2B1E4D7A6C31
@@ -0,0 +1,804 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file threaded_sort_benchmark.cpp
+/// @brief Benchmarks of Threaded_sort class compared with std::sort and parallel std::sort.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+///
+/// Benchmark name: <engine>/<element type>/<distribution>/size:<count of elements>/threads:<count of CPUs>.
+/// Sorting of many tiny arrays: <sort_fixed|std_sort>/int32/arrays_of:<count of elements in array>.
+/// Direct and indirect sorting of large records: <direct_sort|indirect_sort>/record<bytes>/random/size:<count>.
+/// Sorting of many groups in one vector: <segmented_sort|quick_sort_per_group>/int32/groups:<count of groups>.
+/// Sorting by derived keys: <sort_by_key|quick_sort_parsing_keys>/text_record/size:<count of records>.
+/// Sorting by worker processes: sharded_sort/int64/size:<count>/processes:<maximum count of processes>.
+/// Additional command line options (all Google Benchmark options are supported as well):
+///   --min_size=N    Minimum count of elements (default 1000).
+///   --max_size=N    Maximum count of elements (default 1000000, up to 1000000000).
+///   --max_threads=N Maximum count of CPUs used by sort (default: all CPUs available to process).
+/// Machine-readable results: --benchmark_out=<file> --benchmark_out_format=json (see run_benchmark target).
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+#include "benchmark_data.h"
+
+using namespace std;
+
+using namespace My_cpp_libs;
+
+namespace
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sort engine compared by benchmarks.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum class Engine
+{
+  threaded_sort, // Threaded_sort::quick_sort.
+  std_sort,      // std::sort.
+  std_sort_par   // std::sort(std::execution::par, ...).
+};
+
+const char* get_engine_name(Engine engine)
+{
+  switch (engine)
+  {
+  case Engine::threaded_sort: return "threaded_sort";
+  case Engine::std_sort:      return "std_sort";
+  case Engine::std_sort_par:  return "std_sort_par";
+  }
+
+  assert(false);
+
+  return "unknown";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Thread_count_scope: restricts count of CPUs used by sort engines while object exists.
+///        CPU affinity of the calling thread is inherited by all threads it creates (Threaded_sort tasks),
+///        TBB workers (std::execution::par) are limited by tbb::global_control.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Thread_count_scope final
+{
+public:
+
+  /// @brief Gets count of CPUs available to process.
+  static int32_t get_available_cpus_count()
+  {
+#ifdef __linux__
+    cpu_set_t cpu_set;
+
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+    {
+      return CPU_COUNT(&cpu_set);
+    }
+#endif
+
+    return max<int32_t>(static_cast<int32_t>(thread::hardware_concurrency()), 1);
+  }
+
+  /// @brief Constructor.
+  /// @param threads_count Count of CPUs which can be used (should be positive value).
+  explicit Thread_count_scope(int32_t threads_count)
+#if defined(THREADED_SORT_BENCHMARK_HAS_TBB)
+    : m_tbb_control(tbb::global_control::max_allowed_parallelism, static_cast<size_t>(threads_count))
+#endif
+  {
+    assert(threads_count > 0);
+
+#ifdef __linux__
+    m_is_affinity_changed = false;
+
+    if (sched_getaffinity(0, sizeof(m_saved_cpu_set), &m_saved_cpu_set) != 0)
+    {
+      return;
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    int32_t cpus_count = 0;
+
+    for (int32_t cpu = 0; cpu < CPU_SETSIZE && cpus_count < threads_count; cpu++)
+    {
+      if (CPU_ISSET(cpu, &m_saved_cpu_set))
+      {
+        CPU_SET(cpu, &cpu_set);
+        cpus_count++;
+      }
+    }
+
+    m_is_affinity_changed = (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0);
+#endif
+  }
+
+  /// @brief Destructor: restores CPU affinity of the calling thread.
+  ~Thread_count_scope()
+  {
+#ifdef __linux__
+    if (m_is_affinity_changed)
+    {
+      sched_setaffinity(0, sizeof(m_saved_cpu_set), &m_saved_cpu_set);
+    }
+#endif
+  }
+
+private:
+
+  // Private copy constructor without implementation to prohibit using it.
+  Thread_count_scope(const Thread_count_scope&);
+
+  // Private assignment operator without implementation to prohibit using it.
+  Thread_count_scope& operator=(const Thread_count_scope&);
+
+#ifdef __linux__
+  // CPU affinity of the calling thread before construction.
+  cpu_set_t m_saved_cpu_set;
+
+  // Flag: CPU affinity was changed and should be restored.
+  bool m_is_affinity_changed;
+#endif
+
+#if defined(THREADED_SORT_BENCHMARK_HAS_TBB)
+  // Limit of TBB worker threads.
+  tbb::global_control m_tbb_control;
+#endif
+}; // class Thread_count_scope
+
+/// @brief Sorts vector with given engine.
+template <class T>
+void sort_vector(Engine engine, vector<T>& some_vector)
+{
+  switch (engine)
+  {
+  case Engine::threaded_sort:
+    Threaded_sort::quick_sort<T>(some_vector); // exception
+    break;
+
+  case Engine::std_sort:
+    sort(some_vector.begin(), some_vector.end());
+    break;
+
+  case Engine::std_sort_par:
+#if defined(THREADED_SORT_BENCHMARK_HAS_TBB)
+    sort(execution::par, some_vector.begin(), some_vector.end());
+#else
+    assert(false);
+#endif
+    break;
+  }
+}
+
+/// @brief Benchmark function: sorts copy of generated input on every iteration.
+/// @param state Benchmark state: range(0) is count of elements, range(1) is count of CPUs.
+template <class T>
+void benchmark_sort(benchmark::State& state, Engine engine, Distribution distribution)
+{
+  const size_t size = static_cast<size_t>(state.range(0));
+  const int32_t threads_count = static_cast<int32_t>(state.range(1));
+
+  vector<T> input_vector;
+  vector<T> work_vector;
+
+  try
+  {
+    generate_vector<T>(distribution, size, input_vector); // exception
+  }
+  catch (bad_alloc&)
+  {
+    state.SkipWithError("not enough memory for input data");
+    return;
+  }
+
+  Thread_count_scope thread_count_scope(threads_count);
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    work_vector = input_vector; // exception
+    state.ResumeTiming();
+
+    try
+    {
+      sort_vector<T>(engine, work_vector); // exception
+    }
+    catch (exception& error)
+    {
+      state.SkipWithError(error.what());
+      return;
+    }
+
+    benchmark::DoNotOptimize(work_vector.data());
+    benchmark::ClobberMemory();
+  }
+
+  if (!is_sorted(work_vector.begin(), work_vector.end()))
+  {
+    state.SkipWithError("result is not sorted");
+    return;
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size * sizeof(T)));
+}
+
+/// @brief Benchmark function: sorts many independent arrays of N elements.
+/// @param is_network Flag: sort by Sorting_network::sort_fixed<N> instead of std::sort.
+template <size_t N>
+void benchmark_sort_fixed(benchmark::State& state, bool is_network)
+{
+  const size_t arrays_count = 1 << 16;
+
+  vector<int32_t> input_vector;
+
+  generate_vector<int32_t>(Distribution::random, arrays_count * N, input_vector); // exception
+
+  vector<int32_t> work_vector;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    work_vector = input_vector; // exception
+    state.ResumeTiming();
+
+    for (size_t i = 0; i < arrays_count; i++)
+    {
+      int32_t* elements = work_vector.data() + i * N;
+
+      if (is_network)
+      {
+        Sorting_network::sort_fixed<N>(elements);
+      }
+      else
+      {
+        sort(elements, elements + N);
+      }
+    }
+
+    benchmark::DoNotOptimize(work_vector.data());
+    benchmark::ClobberMemory();
+  }
+
+  for (size_t i = 0; i < arrays_count; i++)
+  {
+    if (!is_sorted(work_vector.begin() + i * N, work_vector.begin() + (i + 1) * N))
+    {
+      state.SkipWithError("result is not sorted");
+      return;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(arrays_count));
+}
+
+/// @brief Registers benchmarks of sorting many arrays of N elements.
+template <size_t N>
+void register_fixed_benchmarks()
+{
+  const string suffix = "/int32/arrays_of:" + to_string(N);
+
+  benchmark::RegisterBenchmark(("sort_fixed" + suffix).c_str(), benchmark_sort_fixed<N>, true);
+  benchmark::RegisterBenchmark(("std_sort" + suffix).c_str(), benchmark_sort_fixed<N>, false);
+}
+
+/// @brief Benchmark function: sorts many independent groups of random size (1..32 elements) stored in one vector.
+/// @param state Benchmark state: range(0) is count of groups.
+/// @param is_segmented Flag: sort by Threaded_sort::segmented_sort instead of quick_sort call per group.
+void benchmark_segmented_sort(benchmark::State& state, bool is_segmented)
+{
+  const int32_t groups_count = static_cast<int32_t>(state.range(0));
+
+  mt19937 generator(groups_count);
+  uniform_int_distribution<int32_t> group_size(1, 32);
+
+  vector<int32_t> offsets(1, 0);
+
+  for (int32_t group = 0; group < groups_count; group++)
+  {
+    offsets.push_back(offsets.back() + group_size(generator));
+  }
+
+  vector<int32_t> input_vector;
+
+  generate_vector<int32_t>(Distribution::random, offsets.back(), input_vector); // exception
+
+  vector<int32_t> work_vector;
+  vector<int32_t> group_vector;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    work_vector = input_vector; // exception
+    state.ResumeTiming();
+
+    if (is_segmented)
+    {
+      Threaded_sort::segmented_sort(work_vector, offsets); // exception
+    }
+    else
+    {
+      for (int32_t group = 0; group < groups_count; group++)
+      {
+        group_vector.assign(work_vector.begin() + offsets[group], work_vector.begin() + offsets[group + 1]);
+
+        Threaded_sort::quick_sort(group_vector); // exception
+
+        copy(group_vector.begin(), group_vector.end(), work_vector.begin() + offsets[group]);
+      }
+    }
+
+    benchmark::DoNotOptimize(work_vector.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(offsets.back()));
+}
+
+/// @brief Benchmark function: merges sorted shards of random keys by multiway merge or sorts their
+///        concatenation by threaded quick sort.
+/// @param state Benchmark state: range(0) is count of shards, range(1) is total count of elements.
+/// @param is_merged Flag: shards are merged by Threaded_sort::multiway_merge.
+void benchmark_multiway_merge(benchmark::State& state, bool is_merged)
+{
+  const int32_t shards_count = static_cast<int32_t>(state.range(0));
+  const int32_t size = static_cast<int32_t>(state.range(1));
+
+  vector<int32_t> input_vector;
+
+  generate_vector<int32_t>(Distribution::random, size, input_vector); // exception
+
+  vector<vector<int32_t>> shards(shards_count);
+
+  for (int32_t shard = 0; shard < shards_count; shard++)
+  {
+    shards[shard].assign(input_vector.begin() + static_cast<int64_t>(size) * shard / shards_count,
+      input_vector.begin() + static_cast<int64_t>(size) * (shard + 1) / shards_count); // exception
+
+    sort(shards[shard].begin(), shards[shard].end());
+  }
+
+  vector<int32_t> work_vector;
+
+  for (auto _ : state)
+  {
+    if (is_merged)
+    {
+      Threaded_sort::multiway_merge(shards, work_vector); // exception
+    }
+    else
+    {
+      work_vector.clear();
+
+      for (const vector<int32_t>& shard : shards)
+      {
+        work_vector.insert(work_vector.end(), shard.begin(), shard.end()); // exception
+      }
+
+      Threaded_sort::quick_sort(work_vector); // exception
+    }
+
+    benchmark::DoNotOptimize(work_vector.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// @brief Benchmark function: adds batch of random keys to sorted vector by batch merge or sorts vector with
+///        appended batch by threaded quick sort (copy of sorted vector is included in both).
+/// @param state Benchmark state: range(0) is count of elements in sorted vector, range(1) is size of batch.
+/// @param is_merged Flag: batch is merged by Threaded_sort::merge_batch.
+void benchmark_merge_batch(benchmark::State& state, bool is_merged)
+{
+  const int32_t size = static_cast<int32_t>(state.range(0));
+  const int32_t batch_size = static_cast<int32_t>(state.range(1));
+
+  vector<int32_t> sorted_vector;
+  vector<int32_t> batch_vector;
+
+  generate_vector<int32_t>(Distribution::random, size, sorted_vector); // exception
+  generate_vector<int32_t>(Distribution::random, batch_size, batch_vector); // exception
+
+  sort(sorted_vector.begin(), sorted_vector.end());
+
+  vector<int32_t> work_vector;
+  vector<int32_t> work_batch;
+
+  for (auto _ : state)
+  {
+    work_vector = sorted_vector; // exception
+
+    if (is_merged)
+    {
+      work_batch = batch_vector; // exception
+
+      Threaded_sort::merge_batch(work_vector, work_batch); // exception
+    }
+    else
+    {
+      work_vector.insert(work_vector.end(), batch_vector.begin(), batch_vector.end()); // exception
+
+      Threaded_sort::quick_sort(work_vector); // exception
+    }
+
+    benchmark::DoNotOptimize(work_vector.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch_size));
+}
+
+/// @brief Benchmark function: sorts vector of random keys and removes duplicates by fused sort_unique or by
+///        threaded quick sort followed by std::unique.
+/// @param state Benchmark state: range(0) is count of elements, range(1) is count of distinct keys.
+/// @param is_fused Flag: duplicates are removed by Threaded_sort::sort_unique.
+void benchmark_sort_unique(benchmark::State& state, bool is_fused)
+{
+  const int32_t size = static_cast<int32_t>(state.range(0));
+  const int32_t keys_count = static_cast<int32_t>(state.range(1));
+
+  vector<int32_t> input_vector;
+
+  generate_vector<int32_t>(Distribution::random, size, input_vector); // exception
+
+  for (int32_t& element : input_vector)
+  {
+    element = static_cast<int32_t>(static_cast<uint32_t>(element) % static_cast<uint32_t>(keys_count));
+  }
+
+  vector<int32_t> work_vector;
+
+  for (auto _ : state)
+  {
+    work_vector = input_vector; // exception
+
+    if (is_fused)
+    {
+      work_vector.resize(Threaded_sort::sort_unique(work_vector)); // exception
+    }
+    else
+    {
+      Threaded_sort::quick_sort(work_vector); // exception
+
+      work_vector.erase(unique(work_vector.begin(), work_vector.end()), work_vector.end());
+    }
+
+    benchmark::DoNotOptimize(work_vector.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+/// @brief Benchmark function: sorts vector of random keys by several worker processes.
+/// @param state Benchmark state: range(0) is count of elements, range(1) is maximum count of processes.
+void benchmark_sharded_sort(benchmark::State& state)
+{
+  vector<int64_t> input_vector;
+
+  generate_vector<int64_t>(Distribution::random, static_cast<size_t>(state.range(0)), input_vector); // exception
+
+  const int32_t processes_count = static_cast<int32_t>(state.range(1));
+
+  vector<int64_t> work_vector;
+
+  for (auto _ : state)
+  {
+    work_vector = input_vector; // exception
+
+    Threaded_sort::sharded_sort(work_vector, processes_count); // exception
+
+    benchmark::DoNotOptimize(work_vector.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input_vector.size()));
+}
+
+/// @brief Text record which key is parsed from text ("id=<number>;...").
+struct Text_record
+{
+  string text;
+};
+
+/// @brief Parses key of text record.
+int64_t parse_key(const Text_record& record)
+{
+  return strtoll(record.text.c_str() + 3, nullptr, 10);
+}
+
+bool operator<(const Text_record& left, const Text_record& right)
+{
+  return (parse_key(left) < parse_key(right));
+}
+
+/// @brief Benchmark function: sorts text records by parsed keys with keys cached by sort_by_key (parsed once per
+///        record) or by threaded quick sort which parses keys on every comparison.
+/// @param state Benchmark state: range(0) is count of records.
+/// @param is_cached Flag: keys are cached by Threaded_sort::sort_by_key.
+void benchmark_sort_by_key(benchmark::State& state, bool is_cached)
+{
+  vector<uint64_t> keys;
+
+  generate_keys(Distribution::random, static_cast<size_t>(state.range(0)), keys); // exception
+
+  vector<Text_record> input_vector;
+
+  for (uint64_t key : keys)
+  {
+    input_vector.push_back(Text_record{ "id=" + to_string(key) + ";payload" }); // exception
+  }
+
+  vector<Text_record> work_vector;
+
+  for (auto _ : state)
+  {
+    work_vector = input_vector; // exception
+
+    if (is_cached)
+    {
+      Threaded_sort::sort_by_key(work_vector, parse_key); // exception
+    }
+    else
+    {
+      Threaded_sort::quick_sort(work_vector); // exception
+    }
+
+    benchmark::DoNotOptimize(work_vector.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input_vector.size()));
+}
+
+/// @brief Benchmark function: sorts vector of large records (random keys) directly or indirectly.
+/// @param <Size> Size of record in bytes.
+/// @param state Benchmark state: range(0) is count of records.
+/// @param is_indirect Flag: sort indirectly (pointers are sorted, then records are moved once).
+template <size_t Size>
+void benchmark_large_records(benchmark::State& state, bool is_indirect)
+{
+  vector<uint64_t> keys;
+
+  generate_keys(Distribution::random, static_cast<size_t>(state.range(0)), keys); // exception
+
+  vector<Large_record<Size>> input_vector(keys.size()); // exception
+
+  for (size_t i = 0; i < keys.size(); i++)
+  {
+    input_vector[i].key = static_cast<int64_t>(keys[i]);
+  }
+
+  Sort_parameters parameters = Threaded_sort::get_tuned_parameters<Large_record<Size>>(); // exception
+
+  parameters.indirect_sort_element_size = is_indirect ? 1 : 0;
+
+  vector<Large_record<Size>> work_vector;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    work_vector = input_vector; // exception
+    state.ResumeTiming();
+
+    Threaded_sort::quick_sort(work_vector, parameters); // exception
+
+    benchmark::DoNotOptimize(work_vector.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(Size));
+}
+
+/// @brief Registers direct and indirect sort benchmarks of records of given size (100 MB of records).
+template <size_t Size>
+void register_large_record_benchmarks()
+{
+  const string name = "record" + to_string(Size) + "/random";
+  const int64_t count = 100000000 / Size;
+
+  benchmark::RegisterBenchmark(("direct_sort/" + name).c_str(), benchmark_large_records<Size>, false)->
+    ArgName("size")->Arg(count)->Unit(benchmark::kMillisecond)->UseRealTime();
+  benchmark::RegisterBenchmark(("indirect_sort/" + name).c_str(), benchmark_large_records<Size>, true)->
+    ArgName("size")->Arg(count)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Benchmark options parsed from command line.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Benchmark_options
+{
+  int64_t min_size = 1000;
+  int64_t max_size = 1000000;
+  int32_t max_threads = 0; // 0: all CPUs available to process.
+};
+
+/// @brief Parses and removes own options from command line (remaining ones are passed to Google Benchmark).
+/// @exception std::invalid_argument Invalid value of option.
+Benchmark_options parse_options(int& argc, char* argv[])
+{
+  Benchmark_options options;
+
+  int remaining_count = 1;
+
+  for (int i = 1; i < argc; i++)
+  {
+    const char* argument = argv[i];
+
+    if (strncmp(argument, "--min_size=", 11) == 0)
+    {
+      options.min_size = stoll(argument + 11); // exception
+    }
+    else if (strncmp(argument, "--max_size=", 11) == 0)
+    {
+      options.max_size = stoll(argument + 11); // exception
+    }
+    else if (strncmp(argument, "--max_threads=", 14) == 0)
+    {
+      options.max_threads = stoi(argument + 14); // exception
+    }
+    else
+    {
+      argv[remaining_count++] = argv[i];
+    }
+  }
+
+  argc = remaining_count;
+
+  if (options.min_size < 2 || options.max_size < options.min_size)
+  {
+    throw invalid_argument("min_size/max_size");
+  }
+
+  if (options.max_threads < 0)
+  {
+    throw invalid_argument("max_threads");
+  }
+
+  return options;
+}
+
+/// @brief Registers benchmarks of all engines and distributions for given element type.
+template <class T>
+void register_benchmarks(const vector<int64_t>& sizes, const vector<int64_t>& threads_counts)
+{
+  vector<Engine> engines = { Engine::threaded_sort, Engine::std_sort };
+
+#if defined(THREADED_SORT_BENCHMARK_HAS_TBB)
+  engines.push_back(Engine::std_sort_par);
+#endif
+
+  for (Engine engine : engines)
+  {
+    for (Distribution distribution : s_all_distributions)
+    {
+      string name = string(get_engine_name(engine)) + "/" + Element_traits<T>::name() + "/" +
+        get_distribution_name(distribution);
+
+      benchmark::internal::Benchmark* some_benchmark =
+        benchmark::RegisterBenchmark(name.c_str(), benchmark_sort<T>, engine, distribution);
+
+      some_benchmark->ArgNames({ "size", "threads" })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+      for (int64_t size : sizes)
+      {
+        // std::sort is single threaded: it is measured once per size.
+        if (engine == Engine::std_sort)
+        {
+          some_benchmark->Args({ size, 1 });
+          continue;
+        }
+
+        for (int64_t threads_count : threads_counts)
+        {
+          some_benchmark->Args({ size, threads_count });
+        }
+      }
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  Benchmark_options options;
+
+  try
+  {
+    options = parse_options(argc, argv); // exception
+  }
+  catch (exception& error)
+  {
+    fprintf(stderr, "Invalid command line option: %s\n", error.what());
+    return 1;
+  }
+
+  // Sizes: powers of 10 from min_size to max_size.
+  vector<int64_t> sizes;
+
+  for (int64_t size = options.min_size; size <= options.max_size; size *= 10)
+  {
+    sizes.push_back(size);
+  }
+
+  // Threads counts: powers of 2 up to max_threads and max_threads itself.
+  int32_t max_threads = Thread_count_scope::get_available_cpus_count();
+
+  if (options.max_threads > 0)
+  {
+    max_threads = min(max_threads, options.max_threads);
+  }
+
+  vector<int64_t> threads_counts;
+
+  for (int32_t threads_count = 1; threads_count < max_threads; threads_count *= 2)
+  {
+    threads_counts.push_back(threads_count);
+  }
+
+  threads_counts.push_back(max_threads);
+
+  register_benchmarks<int32_t>(sizes, threads_counts);
+  register_benchmarks<int64_t>(sizes, threads_counts);
+  register_benchmarks<double>(sizes, threads_counts);
+  register_benchmarks<Record_16>(sizes, threads_counts);
+  register_benchmarks<string>(sizes, threads_counts);
+
+  register_fixed_benchmarks<4>();
+  register_fixed_benchmarks<8>();
+  register_fixed_benchmarks<16>();
+  register_fixed_benchmarks<32>();
+
+  register_large_record_benchmarks<128>();
+  register_large_record_benchmarks<256>();
+  register_large_record_benchmarks<512>();
+  register_large_record_benchmarks<1024>();
+
+  benchmark::RegisterBenchmark("segmented_sort/int32", benchmark_segmented_sort, true)->
+    ArgName("groups")->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+  benchmark::RegisterBenchmark("quick_sort_per_group/int32", benchmark_segmented_sort, false)->
+    ArgName("groups")->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+  benchmark::RegisterBenchmark("multiway_merge/int32", benchmark_multiway_merge, true)->
+    ArgNames({ "shards", "size" })->Args({ 64, 4000000 })->Unit(benchmark::kMillisecond)->UseRealTime();
+  benchmark::RegisterBenchmark("quick_sort_of_shards/int32", benchmark_multiway_merge, false)->
+    ArgNames({ "shards", "size" })->Args({ 64, 4000000 })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+  benchmark::RegisterBenchmark("merge_batch/int32", benchmark_merge_batch, true)->
+    ArgNames({ "size", "batch" })->Args({ 4000000, 40000 })->Args({ 4000000, 400000 })->
+    Unit(benchmark::kMillisecond)->UseRealTime();
+  benchmark::RegisterBenchmark("quick_sort_after_append/int32", benchmark_merge_batch, false)->
+    ArgNames({ "size", "batch" })->Args({ 4000000, 40000 })->Args({ 4000000, 400000 })->
+    Unit(benchmark::kMillisecond)->UseRealTime();
+
+  benchmark::RegisterBenchmark("sort_unique/int32", benchmark_sort_unique, true)->
+    ArgNames({ "size", "keys" })->Args({ 4000000, 1000 })->Args({ 4000000, 4000000 })->
+    Unit(benchmark::kMillisecond)->UseRealTime();
+  benchmark::RegisterBenchmark("quick_sort_then_unique/int32", benchmark_sort_unique, false)->
+    ArgNames({ "size", "keys" })->Args({ 4000000, 1000 })->Args({ 4000000, 4000000 })->
+    Unit(benchmark::kMillisecond)->UseRealTime();
+
+  benchmark::RegisterBenchmark("sort_by_key/text_record", benchmark_sort_by_key, true)->
+    ArgNames({ "size" })->Arg(1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+  benchmark::RegisterBenchmark("quick_sort_parsing_keys/text_record", benchmark_sort_by_key, false)->
+    ArgNames({ "size" })->Arg(1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+  benchmark::RegisterBenchmark("sharded_sort/int64", benchmark_sharded_sort)->
+    ArgNames({ "size", "processes" })->Args({ 4000000, 1 })->Args({ 4000000, 2 })->Args({ 4000000, 4 })->
+    Unit(benchmark::kMillisecond)->UseRealTime();
+
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+  {
+    return 1;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  benchmark::Shutdown();
+
+  return 0;
+}
@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file allocation_counter.cpp
+/// @brief Implementation of the Allocation_counter class and replaced global operator new.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+#include "allocation_counter.h"
+
+using namespace std;
+
+const size_t Allocation_counter::s_large_allocation_size;
+
+atomic<bool> Allocation_counter::s_is_counting(false);
+
+atomic<int32_t> Allocation_counter::s_large_allocations_count(0);
+
+void Allocation_counter::on_allocation(size_t size)
+{
+  if (size >= s_large_allocation_size && s_is_counting)
+  {
+    s_large_allocations_count++;
+  }
+}
+
+// Replaced global operator new (operator new[] and nothrow versions call it): allocations are counted.
+void* operator new(size_t size)
+{
+  Allocation_counter::on_allocation(size);
+
+  void* memory = malloc((size > 0) ? size : 1);
+
+  if (memory == nullptr)
+  {
+    throw bad_alloc();
+  }
+
+  return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+  free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+  free(memory);
+}
@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file allocation_counter.h
+/// @brief Interface of the Allocation_counter class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ALLOCATION_COUNTER_H_0B5E2F4C_7D1A_4E38_9C62_3A8F0D6B1E57
+#define ALLOCATION_COUNTER_H_0B5E2F4C_7D1A_4E38_9C62_3A8F0D6B1E57
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Class Allocation_counter: counts large heap allocations (e.g. scratch buffers of sort) made by any thread
+///        through global operator new, which is replaced in allocation_counter.cpp.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Allocation_counter
+{
+public:
+
+  // Minimum size of counted allocation in bytes.
+  static const size_t s_large_allocation_size = 64 * 1024;
+
+  /// @brief Counts large heap allocations made while function is executed.
+  /// @param <Function> Function void().
+  /// @param function Function.
+  template<class Function>
+  static int32_t count_large_allocations(Function function);
+
+  /// @brief Handles allocation made by global operator new.
+  /// @param size Size of allocation in bytes.
+  static void on_allocation(size_t size);
+
+private:
+
+  // Flag: large allocations are counted.
+  static std::atomic<bool> s_is_counting;
+
+  // Count of large allocations made while they are counted.
+  static std::atomic<int32_t> s_large_allocations_count;
+};
+
+template<class Function>
+int32_t Allocation_counter::count_large_allocations(Function function)
+{
+  s_large_allocations_count = 0;
+  s_is_counting = true;
+
+  function();
+
+  s_is_counting = false;
+
+  return s_large_allocations_count;
+}
+
+#endif // ALLOCATION_COUNTER_H_0B5E2F4C_7D1A_4E38_9C62_3A8F0D6B1E57
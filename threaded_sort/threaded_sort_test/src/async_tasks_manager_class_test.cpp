@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file async_tasks_manager_class_test.cpp
+/// @brief Test of Async_tasks_manager class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+
+using namespace std;
+
+using namespace My_cpp_libs;
+
+// Task which completes at once (often before its thread is assigned), optionally with error.
+class Instant_async_task final : public Async_task
+{
+public:
+
+  Instant_async_task(shared_ptr<Async_tasks_manager> tasks_manager, bool is_failing) :
+    m_tasks_manager(tasks_manager),
+    m_is_failing(is_failing)
+  {
+  }
+
+private:
+
+  virtual void _do_in_background() override
+  {
+    if (m_is_failing)
+    {
+      shared_ptr<exception> error = make_shared<runtime_error>("Task failed.");
+
+      Async_task::_on_error(error);
+
+      m_tasks_manager->handle_task_completion(get_task_id(), error);
+
+      return;
+    }
+
+    m_tasks_manager->handle_task_completion(get_task_id(), nullptr);
+
+    _set_status(Status::completed);
+  }
+
+  shared_ptr<Async_tasks_manager> m_tasks_manager;
+
+  const bool m_is_failing;
+};
+
+TEST(AsyncTasksManagerClassTest, JoinThreadsOfCompletedTasks)
+{
+  // Tasks complete concurrently with each other and with waiting thread: no deadlock, every thread is joined.
+  for (int32_t iteration = 0; iteration < 200; iteration++)
+  {
+    shared_ptr<Async_tasks_manager> tasks_manager = make_shared<Async_tasks_manager>();
+
+    vector<shared_ptr<Async_task>> tasks;
+
+    for (int32_t task = 0; task < 8; task++)
+    {
+      tasks.push_back(make_shared<Instant_async_task>(tasks_manager, false));
+
+      tasks_manager->add_task(tasks.back());
+
+      tasks.back()->execute();
+    }
+
+    ASSERT_NO_THROW(tasks_manager->wait_for_all_tasks_completion()); // exception
+
+    EXPECT_TRUE(tasks_manager->are_all_tasks_completed());
+    EXPECT_FALSE(tasks_manager->is_error_occurred());
+
+    for (const shared_ptr<Async_task>& task : tasks)
+    {
+      EXPECT_EQ(Async_task::Status::completed, task->get_status());
+      ASSERT_FALSE(task->get_thread().joinable());
+    }
+  }
+}
+
+TEST(AsyncTasksManagerClassTest, ErrorOfFailedTask)
+{
+  shared_ptr<Async_tasks_manager> tasks_manager = make_shared<Async_tasks_manager>();
+
+  vector<shared_ptr<Async_task>> tasks;
+
+  for (int32_t task = 0; task < 4; task++)
+  {
+    tasks.push_back(make_shared<Instant_async_task>(tasks_manager, task == 2));
+
+    tasks_manager->add_task(tasks.back());
+
+    tasks.back()->execute();
+  }
+
+  ASSERT_NO_THROW(tasks_manager->wait_for_all_tasks_completion()); // exception
+
+  EXPECT_TRUE(tasks_manager->is_error_occurred());
+  ASSERT_NE(nullptr, tasks_manager->get_error());
+  EXPECT_STREQ("Task failed.", tasks_manager->get_error()->what());
+
+  EXPECT_TRUE(tasks[2]->is_failed());
+  EXPECT_FALSE(tasks[0]->is_failed());
+
+  for (const shared_ptr<Async_task>& task : tasks)
+  {
+    EXPECT_FALSE(task->get_thread().joinable());
+  }
+}
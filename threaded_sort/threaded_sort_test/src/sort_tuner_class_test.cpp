@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file sort_tuner_class_test.cpp
+/// @brief Test of Sort_tuner and Tuning_profile classes.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+#include "threaded_sort_class_test.h"
+
+using namespace std;
+
+using namespace My_cpp_libs;
+
+TEST(SortTunerClassTest, Calibrate)
+{
+  vector<int32_t> sample;
+
+  for (int32_t i = 0; i < 20000; i++)
+  {
+    sample.push_back((i * 7919) % 20011);
+  }
+
+  Tuning_profile profile;
+
+  ASSERT_NO_THROW(Sort_tuner::calibrate(sample, profile)); // exception
+
+  EXPECT_FALSE(profile.is_empty());
+
+  Sort_parameters parameters = profile.get_parameters(typeid(int32_t).name(), sizeof(int32_t));
+
+  EXPECT_TRUE(parameters.is_valid());
+
+  ASSERT_NO_THROW(Threaded_sort::quick_sort(sample, parameters)); // exception
+
+  EXPECT_TRUE(ThreadedSortClassTest::check_vector_for_ascending_sort(sample));
+
+  vector<int32_t> too_small_sample(1, 0);
+
+  EXPECT_THROW(Sort_tuner::calibrate(too_small_sample), invalid_argument);
+}
+
+TEST(SortTunerClassTest, SaveAndLoadProfile)
+{
+  const string file_path = "sort_tuner_class_test.profile";
+
+  Sort_parameters int_parameters;
+  int_parameters.max_recursion_depth = 4;
+  int_parameters.min_task_size = 1024;
+  int_parameters.insertion_sort_threshold = 32;
+  int_parameters.sequential_sort_threshold = 4096;
+  int_parameters.indirect_sort_element_size = 256;
+  int_parameters.adaptive_run_length = 0;
+
+  Sort_parameters string_parameters;
+  string_parameters.max_recursion_depth = 8;
+
+  Tuning_profile profile;
+
+  ASSERT_NO_THROW(profile.set_parameters(typeid(int32_t).name(), sizeof(int32_t), int_parameters)); // exception
+  ASSERT_NO_THROW(profile.set_parameters("class std::string", sizeof(string), string_parameters)); // exception
+
+  ASSERT_NO_THROW(profile.save(file_path)); // exception
+
+  Tuning_profile loaded_profile;
+
+  ASSERT_NO_THROW(loaded_profile.load(file_path)); // exception
+
+  remove(file_path.c_str());
+
+  Sort_parameters parameters = loaded_profile.get_parameters(typeid(int32_t).name(), sizeof(int32_t));
+
+  EXPECT_EQ(4, parameters.max_recursion_depth);
+  EXPECT_EQ(1024, parameters.min_task_size);
+  EXPECT_EQ(32, parameters.insertion_sort_threshold);
+  EXPECT_EQ(4096, parameters.sequential_sort_threshold);
+  EXPECT_EQ(256, parameters.indirect_sort_element_size);
+  EXPECT_EQ(0, parameters.adaptive_run_length);
+
+  // Type name with spaces is read up to the end of line.
+  EXPECT_EQ(8, loaded_profile.get_parameters("class std::string", sizeof(string)).max_recursion_depth);
+
+  // Unknown type gets parameters of type with the nearest element size.
+  EXPECT_EQ(4, loaded_profile.get_parameters("unknown", 2).max_recursion_depth);
+
+  EXPECT_THROW(loaded_profile.load("not_existing_file.profile"), runtime_error);
+
+  // Profile of version 1 (without version line): parameters added later get default values.
+  {
+    ofstream file(file_path);
+
+    file << "# element_size max_recursion_depth min_task_size insertion_sort_threshold sequential_sort_threshold "
+      "type\n";
+    file << "4 6 2048 24 8192 int\n";
+  }
+
+  ASSERT_NO_THROW(loaded_profile.load(file_path)); // exception
+
+  parameters = loaded_profile.get_parameters("int", sizeof(int32_t));
+
+  EXPECT_EQ(6, parameters.max_recursion_depth);
+  EXPECT_EQ(8192, parameters.sequential_sort_threshold);
+  EXPECT_EQ(Sort_parameters().indirect_sort_element_size, parameters.indirect_sort_element_size);
+  EXPECT_EQ(Sort_parameters().adaptive_run_length, parameters.adaptive_run_length);
+
+  // Profile of unknown version is not loaded.
+  {
+    ofstream file(file_path);
+
+    file << "version 3\n";
+    file << "4 6 2048 24 8192 512 64 0 int\n";
+  }
+
+  EXPECT_THROW(loaded_profile.load(file_path), runtime_error);
+
+  remove(file_path.c_str());
+}
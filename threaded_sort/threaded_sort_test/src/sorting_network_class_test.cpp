@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file sorting_network_class_test.cpp
+/// @brief Test of Sorting_network class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+#include "threaded_sort_class_test.h"
+
+using namespace std;
+
+using namespace My_cpp_libs;
+
+TEST(SortingNetworkClassTest, ZeroOnePrinciple)
+{
+  // Network sorts all inputs if it sorts all sequences of 0 and 1.
+  for (size_t count = 0; count <= 16; count++)
+  {
+    for (uint32_t bits = 0; bits < (1u << count); bits++)
+    {
+      vector<int32_t> int_vector(count);
+
+      for (size_t i = 0; i < count; i++)
+      {
+        int_vector[i] = (bits >> i) & 1;
+      }
+
+      Sorting_network::sort(int_vector.data(), count);
+
+      ASSERT_TRUE(ThreadedSortClassTest::check_vector_for_ascending_sort(int_vector)) << count << " " << bits;
+    }
+  }
+}
+
+TEST(SortingNetworkClassTest, RandomInput)
+{
+  mt19937 generator(32);
+  uniform_int_distribution<int32_t> uniform(-100, 100);
+
+  for (size_t count = 0; count <= Sorting_network::s_max_size; count++)
+  {
+    for (int32_t attempt = 0; attempt < 1000; attempt++)
+    {
+      vector<double> double_vector(count);
+      vector<string> string_vector(count);
+
+      for (size_t i = 0; i < count; i++)
+      {
+        double_vector[i] = uniform(generator) * 0.5;
+        string_vector[i] = to_string(uniform(generator));
+      }
+
+      vector<double> expected_double_vector = double_vector;
+      vector<string> expected_string_vector = string_vector;
+
+      sort(expected_double_vector.begin(), expected_double_vector.end());
+      sort(expected_string_vector.begin(), expected_string_vector.end());
+
+      Sorting_network::sort(double_vector.data(), count);
+      Sorting_network::sort(string_vector.data(), count);
+
+      ASSERT_EQ(expected_double_vector, double_vector);
+      ASSERT_EQ(expected_string_vector, string_vector);
+    }
+  }
+}
+
+TEST(SortingNetworkClassTest, SortFixed)
+{
+  // Networks are generated at compile time.
+  static_assert(Sorting_network::get_comparators_count<0>() == 0, "Unexpected network size.");
+  static_assert(Sorting_network::get_comparators_count<2>() == 1, "Unexpected network size.");
+  static_assert(Sorting_network::get_comparators_count<4>() == 5, "Unexpected network size.");
+  static_assert(Sorting_network::get_comparators_count<8>() == 19, "Unexpected network size.");
+  static_assert(Sorting_network::get_comparators_count<16>() == 63, "Unexpected network size.");
+  static_assert(Sorting_network::get_comparators_count<32>() == 191, "Unexpected network size.");
+
+  array<int64_t, 7> int_array = { 5, -1, 9, 0, 5, 3, -7 };
+
+  Sorting_network::sort_fixed(int_array);
+
+  EXPECT_EQ((array<int64_t, 7>{ -7, -1, 0, 3, 5, 5, 9 }), int_array);
+
+  uint8_t bytes[32];
+
+  for (size_t i = 0; i < 32; i++)
+  {
+    bytes[i] = static_cast<uint8_t>(31 - i);
+  }
+
+  Sorting_network::sort_fixed<32>(bytes);
+
+  for (size_t i = 0; i < 32; i++)
+  {
+    EXPECT_EQ(i, bytes[i]);
+  }
+}
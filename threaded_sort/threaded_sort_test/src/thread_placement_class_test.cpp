@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file thread_placement_class_test.cpp
+/// @brief Test of Thread_placement class.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+#include "threaded_sort_class_test.h"
+
+using namespace std;
+
+using namespace My_cpp_libs;
+
+TEST(ThreadPlacementClassTest, NumaTopology)
+{
+  shared_ptr<Thread_placement> placement;
+
+  ASSERT_NO_THROW(placement = make_shared<Thread_placement>()); // exception
+
+  EXPECT_FALSE(placement->get_cpus().empty());
+  EXPECT_TRUE(placement->is_numa_aware());
+  ASSERT_GE(placement->get_numa_nodes_count(), 1);
+
+  // Every CPU of every node belongs to placement CPU set.
+  for (int32_t node = 0; node < placement->get_numa_nodes_count(); node++)
+  {
+    for (int32_t cpu : placement->get_node_cpus(node))
+    {
+      EXPECT_TRUE(binary_search(placement->get_cpus().begin(), placement->get_cpus().end(), cpu));
+    }
+  }
+
+  vector<int32_t> int_vector(4096, 1);
+
+  const int32_t node = placement->get_memory_node(int_vector.data());
+
+  EXPECT_GE(node, 0);
+  EXPECT_LT(node, placement->get_numa_nodes_count());
+
+  EXPECT_THROW(Thread_placement(vector<int32_t>(), false), invalid_argument);
+  EXPECT_THROW(Thread_placement(vector<int32_t>(1, -1), false), invalid_argument);
+}
+
+#ifdef __linux__
+
+TEST(ThreadPlacementClassTest, PinCurrentThread)
+{
+  const int32_t cpu = Thread_placement::get_available_cpus().front();
+
+  Thread_placement placement(vector<int32_t>(1, cpu), true);
+
+  bool is_applied = false;
+  bool is_pinned = false;
+
+  vector<int32_t> pinned_thread_available_cpus;
+
+  // Pin separate thread: affinity of test thread is not changed.
+  thread pinned_thread([&]()
+  {
+    is_applied = placement.apply_to_current_thread(&cpu);
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0)
+    {
+      is_pinned = (CPU_COUNT(&cpu_set) == 1 && CPU_ISSET(cpu, &cpu_set));
+    }
+
+    pinned_thread_available_cpus = Thread_placement::get_available_cpus();
+  });
+
+  pinned_thread.join();
+
+  EXPECT_TRUE(is_applied);
+  EXPECT_TRUE(is_pinned);
+
+  // CPUs of process don't depend on affinity of calling thread.
+  EXPECT_EQ(Thread_placement::get_available_cpus(), pinned_thread_available_cpus);
+}
+
+#endif // __linux__
+
+TEST(ThreadPlacementClassTest, QuickSortWithPlacement)
+{
+  vector<int32_t> int_vector;
+
+  for (int32_t i = 0; i < 200000; i++)
+  {
+    int_vector.push_back((i * 7919) % 200003);
+  }
+
+  Sort_parameters parameters;
+  parameters.max_recursion_depth = 1;
+  parameters.min_task_size = 1000;
+  parameters.sequential_sort_threshold = 0;
+
+  const int32_t cpu = Thread_placement::get_available_cpus().back();
+
+  shared_ptr<const Thread_placement> placement = make_shared<Thread_placement>(vector<int32_t>(1, cpu), true);
+
+  ASSERT_NO_THROW(Threaded_sort::quick_sort(int_vector, parameters, placement)); // exception
+
+  EXPECT_TRUE(ThreadedSortClassTest::check_vector_for_ascending_sort(int_vector));
+}
@@ -6,11 +6,171 @@
 
 #include "pch.h"
 #include "threaded_sort_class_test.h"
+#include "allocation_counter.h"
 
 using namespace std;
 
 using namespace My_cpp_libs;
 
+// Large record (200 bytes) sorted indirectly.
+struct Large_record
+{
+  int64_t key;
+  char payload[192];
+};
+
+static bool operator<(const Large_record& left, const Large_record& right)
+{
+  return (left.key < right.key);
+}
+
+// Count of buffers allocated by Counting_allocator<T>.
+static std::atomic<int32_t> s_buffer_allocations_count(0);
+
+// Allocator which counts allocations of buffers (independently of operations of their owner).
+template<class T>
+struct Counting_allocator
+{
+  typedef T value_type;
+
+  Counting_allocator() noexcept
+  {
+  }
+
+  template<class U>
+  Counting_allocator(const Counting_allocator<U>&) noexcept
+  {
+  }
+
+  T* allocate(size_t count)
+  {
+    s_buffer_allocations_count++;
+
+    return std::allocator<T>().allocate(count); // exception
+  }
+
+  void deallocate(T* pointer, size_t count) noexcept
+  {
+    std::allocator<T>().deallocate(pointer, count);
+  }
+};
+
+template<class T, class U>
+static bool operator==(const Counting_allocator<T>&, const Counting_allocator<U>&)
+{
+  return true;
+}
+
+template<class T, class U>
+static bool operator!=(const Counting_allocator<T>&, const Counting_allocator<U>&)
+{
+  return false;
+}
+
+// Heavy element owning heap buffer (key and payload): counts copies, allocations of buffers are counted by
+// Counting_allocator<T>.
+class Counted_element
+{
+public:
+
+  static std::atomic<int32_t> s_copies_count;
+
+  explicit Counted_element(int32_t key) : m_buffer(16, key) // exception
+  {
+  }
+
+  Counted_element(const Counted_element& other) : m_buffer(other.m_buffer) // exception
+  {
+    s_copies_count++;
+  }
+
+  Counted_element(Counted_element&& other) noexcept = default;
+
+  Counted_element& operator=(const Counted_element& other)
+  {
+    m_buffer = other.m_buffer; // exception
+
+    s_copies_count++;
+
+    return *this;
+  }
+
+  Counted_element& operator=(Counted_element&& other) noexcept = default;
+
+  int32_t get_key() const
+  {
+    return m_buffer[0];
+  }
+
+private:
+
+  std::vector<int32_t, Counting_allocator<int32_t>> m_buffer;
+};
+
+std::atomic<int32_t> Counted_element::s_copies_count(0);
+
+static bool operator<(const Counted_element& left, const Counted_element& right)
+{
+  return (left.get_key() < right.get_key());
+}
+
+// Move-only element.
+struct Move_only_element
+{
+  std::unique_ptr<int32_t> key;
+};
+
+static bool operator<(const Move_only_element& left, const Move_only_element& right)
+{
+  return (*left.key < *right.key);
+}
+
+// Element aligned stronger than default alignment of workspace.
+struct alignas(256) Over_aligned_element
+{
+  int64_t key;
+};
+
+// Element with key and index of input: checks order of equal keys.
+struct Keyed_element
+{
+  int32_t key;
+  int32_t input;
+};
+
+static bool operator<(const Keyed_element& left, const Keyed_element& right)
+{
+  return (left.key < right.key);
+}
+
+static bool operator==(const Keyed_element& left, const Keyed_element& right)
+{
+  return (left.key == right.key && left.input == right.input);
+}
+
+#ifdef __linux__
+// Element which can be compared only by the process which started test: comparison in worker process fails.
+struct Parent_only_element
+{
+  int64_t key;
+
+  // Identifier of process which started test.
+  static pid_t s_parent_process_id;
+};
+
+pid_t Parent_only_element::s_parent_process_id = getpid();
+
+static bool operator<(const Parent_only_element& left, const Parent_only_element& right)
+{
+  if (getpid() != Parent_only_element::s_parent_process_id)
+  {
+    throw runtime_error("Element is compared by worker process.");
+  }
+
+  return (left.key < right.key);
+}
+#endif // __linux__
+
 TEST(ThreadedSortClassTest, QuickSort)
 {
   vector<int32_t> int_vector;
@@ -26,3 +186,1234 @@ TEST(ThreadedSortClassTest, QuickSort)
 
   // ToDo: add additional test cases...
 }
+
+TEST(ThreadedSortClassTest, QuickSortWithParameters)
+{
+  vector<int32_t> int_vector;
+
+  for (int32_t i = 0; i < 100000; i++)
+  {
+    int_vector.push_back((i * 7919) % 100003);
+  }
+
+  Sort_parameters parameters;
+  parameters.max_recursion_depth = 2;
+  parameters.min_task_size = 1000;
+  parameters.insertion_sort_threshold = 32;
+  parameters.sequential_sort_threshold = 0;
+
+  ASSERT_NO_THROW(Threaded_sort::quick_sort(int_vector, parameters)); // exception
+
+  EXPECT_TRUE(ThreadedSortClassTest::check_vector_for_ascending_sort(int_vector));
+
+  parameters.min_task_size = 0;
+
+  EXPECT_THROW(Threaded_sort::quick_sort(int_vector, parameters), invalid_argument);
+}
+
+TEST(ThreadedSortClassTest, SegmentedSort)
+{
+  mt19937 generator(30);
+  uniform_int_distribution<int32_t> segment_size(0, 40);
+
+  vector<int32_t> int_vector;
+  vector<int32_t> offsets(1, 0);
+
+  for (int32_t segment = 0; segment < 20000; segment++)
+  {
+    // Several large segments among small ones.
+    const int32_t size = (segment % 5000 == 2500) ? 50000 : segment_size(generator);
+
+    for (int32_t i = 0; i < size; i++)
+    {
+      int_vector.push_back(static_cast<int32_t>(generator() % 1000));
+    }
+
+    offsets.push_back(static_cast<int32_t>(int_vector.size()));
+  }
+
+  vector<int32_t> expected_vector = int_vector;
+
+  for (size_t segment = 0; segment + 1 < offsets.size(); segment++)
+  {
+    sort(expected_vector.begin() + offsets[segment], expected_vector.begin() + offsets[segment + 1]);
+  }
+
+  ASSERT_NO_THROW(Threaded_sort::segmented_sort(int_vector, offsets)); // exception
+
+  EXPECT_EQ(expected_vector, int_vector);
+
+  // Few small segments are sorted without threads.
+  vector<string> string_vector = { "b", "a", "d", "c", "c" };
+
+  ASSERT_NO_THROW(Threaded_sort::segmented_sort(string_vector, { 0, 2, 2, 5 })); // exception
+
+  EXPECT_EQ((vector<string>{ "a", "b", "c", "c", "d" }), string_vector);
+
+  EXPECT_THROW(Threaded_sort::segmented_sort(string_vector, { 0, 3, 2, 5 }), invalid_argument);
+  EXPECT_THROW(Threaded_sort::segmented_sort(string_vector, { 0, 4 }), invalid_argument);
+  EXPECT_THROW(Threaded_sort::segmented_sort(string_vector, {}), invalid_argument);
+}
+
+TEST(ThreadedSortClassTest, IndirectSort)
+{
+  Sort_parameters parameters;
+  parameters.max_recursion_depth = 2;
+  parameters.min_task_size = 1000;
+  parameters.sequential_sort_threshold = 0;
+  parameters.indirect_sort_element_size = 128;
+
+  EXPECT_TRUE(Threaded_sort::is_indirect_sort_used<Large_record>(parameters));
+  EXPECT_FALSE(Threaded_sort::is_indirect_sort_used<int32_t>(parameters));
+  EXPECT_FALSE(Threaded_sort::is_indirect_sort_used<string>(parameters));
+
+  mt19937 generator(31);
+
+  vector<Large_record> record_vector(100000);
+
+  for (Large_record& record : record_vector)
+  {
+    record.key = static_cast<int64_t>(generator() % 50000);
+
+    // Payload identifies the key: records should be moved as whole.
+    fill(begin(record.payload), end(record.payload), static_cast<char>(record.key % 127));
+  }
+
+  ASSERT_NO_THROW(Threaded_sort::quick_sort(record_vector, parameters)); // exception
+
+  bool is_vector_sorted = true;
+  bool are_records_consistent = true;
+
+  for (size_t i = 0; i < record_vector.size(); i++)
+  {
+    is_vector_sorted = is_vector_sorted && (i == 0 || !(record_vector[i] < record_vector[i - 1]));
+
+    are_records_consistent = are_records_consistent && all_of(begin(record_vector[i].payload),
+      end(record_vector[i].payload), [&](char c) { return c == static_cast<char>(record_vector[i].key % 127); });
+  }
+
+  EXPECT_TRUE(is_vector_sorted);
+  EXPECT_TRUE(are_records_consistent);
+
+  // Indirect sort is disabled: records are swapped by partitioning.
+  parameters.indirect_sort_element_size = 0;
+
+  EXPECT_FALSE(Threaded_sort::is_indirect_sort_used<Large_record>(parameters));
+
+  reverse(record_vector.begin(), record_vector.end());
+
+  ASSERT_NO_THROW(Threaded_sort::quick_sort(record_vector, parameters)); // exception
+
+  EXPECT_TRUE(is_sorted(record_vector.begin(), record_vector.end()));
+}
+
+TEST(ThreadedSortClassTest, StringSort)
+{
+  Sort_parameters parameters;
+  parameters.max_recursion_depth = 2;
+  parameters.min_task_size = 500;
+  parameters.sequential_sort_threshold = 0;
+
+  mt19937 generator(32);
+
+  // Long common prefixes, prefixes of each other, embedded zero and non-ASCII characters.
+  const string alphabet("ab\0\xff", 4);
+
+  vector<string> string_vector;
+
+  for (int32_t i = 0; i < 50000; i++)
+  {
+    string key = (i % 3 == 0) ? "https://example.com/some/long/common/path/" : "";
+
+    const int32_t length = static_cast<int32_t>(generator() % 20);
+
+    for (int32_t k = 0; k < length; k++)
+    {
+      key += alphabet[generator() % alphabet.size()];
+    }
+
+    string_vector.push_back(key);
+  }
+
+  vector<string> expected_vector = string_vector;
+
+  sort(expected_vector.begin(), expected_vector.end());
+
+  ASSERT_NO_THROW(Threaded_sort::string_sort(string_vector, parameters)); // exception
+
+  EXPECT_EQ(expected_vector, string_vector);
+
+  // Views of strings stored in one arena.
+  string arena;
+
+  vector<string_view> view_vector;
+
+  for (const string& key : expected_vector)
+  {
+    arena += key;
+  }
+
+  for (size_t offset = 0, i = 0; i < expected_vector.size(); offset += expected_vector[i].size(), i++)
+  {
+    view_vector.push_back(string_view(arena).substr(offset, expected_vector[i].size()));
+  }
+
+  shuffle(view_vector.begin(), view_vector.end(), generator);
+
+  ASSERT_NO_THROW(Threaded_sort::quick_sort(view_vector, parameters)); // exception
+
+  EXPECT_TRUE(equal(view_vector.begin(), view_vector.end(), expected_vector.begin(), expected_vector.end()));
+}
+
+TEST(ThreadedSortClassTest, ElementsAreOnlyMoved)
+{
+  Sort_parameters parameters;
+  parameters.max_recursion_depth = 2;
+  parameters.min_task_size = 500;
+  parameters.sequential_sort_threshold = 0;
+
+  mt19937 generator(33);
+
+  vector<Counted_element> counted_vector;
+
+  s_buffer_allocations_count = 0;
+
+  for (int32_t i = 0; i < 100000; i++)
+  {
+    counted_vector.emplace_back(static_cast<int32_t>(generator() % 1000));
+  }
+
+  // Every element owns one buffer.
+  ASSERT_EQ(100000, s_buffer_allocations_count.load());
+
+  Counted_element::s_copies_count = 0;
+  s_buffer_allocations_count = 0;
+
+  ASSERT_NO_THROW(Threaded_sort::quick_sort(counted_vector, parameters)); // exception
+
+  EXPECT_EQ(0, Counted_element::s_copies_count);
+  EXPECT_EQ(0, s_buffer_allocations_count.load());
+
+  EXPECT_TRUE(is_sorted(counted_vector.begin(), counted_vector.end()));
+
+  // Move-only elements: sorted by threads, in calling thread and in segments.
+  vector<Move_only_element> move_only_vector;
+
+  for (int32_t i = 0; i < 100000; i++)
+  {
+    move_only_vector.push_back(Move_only_element{ std::unique_ptr<int32_t>(new int32_t(i % 777)) });
+  }
+
+  ASSERT_NO_THROW(Threaded_sort::quick_sort(move_only_vector, parameters)); // exception
+
+  EXPECT_TRUE(is_sorted(move_only_vector.begin(), move_only_vector.end()));
+
+  reverse(move_only_vector.begin(), move_only_vector.end());
+
+  ASSERT_NO_THROW(Threaded_sort::quick_sort(move_only_vector)); // exception
+
+  EXPECT_TRUE(is_sorted(move_only_vector.begin(), move_only_vector.end()));
+
+  reverse(move_only_vector.begin(), move_only_vector.end());
+
+  ASSERT_NO_THROW(Threaded_sort::segmented_sort(move_only_vector, { 0, 10, 50000, 100000 })); // exception
+
+  EXPECT_TRUE(is_sorted(move_only_vector.begin() + 10, move_only_vector.begin() + 50000));
+  EXPECT_TRUE(is_sorted(move_only_vector.begin() + 50000, move_only_vector.end()));
+}
+
+TEST(ThreadedSortClassTest, AdaptiveSort)
+{
+  Sort_parameters parameters;
+  parameters.min_task_size = 1000;
+  parameters.sequential_sort_threshold = 0;
+  parameters.adaptive_run_length = 32;
+
+  mt19937 generator(34);
+
+  // Concatenated sorted shards: ascending, descending, with equal elements.
+  vector<int32_t> shards_vector;
+
+  for (int32_t shard = 0; shard < 37; shard++)
+  {
+    const int32_t shard_size = 100 + static_cast<int32_t>(generator() % 10000);
+
+    vector<int32_t> shard_vector;
+
+    for (int32_t i = 0; i < shard_size; i++)
+    {
+      shard_vector.push_back(static_cast<int32_t>(generator() % 5000));
+    }
+
+    sort(shard_vector.begin(), shard_vector.end());
+
+    if (shard % 3 == 1)
+    {
+      shard_vector.erase(unique(shard_vector.begin(), shard_vector.end()), shard_vector.end());
+
+      reverse(shard_vector.begin(), shard_vector.end());
+    }
+
+    shards_vector.insert(shards_vector.end(), shard_vector.begin(), shard_vector.end());
+  }
+
+  vector<int32_t> expected_vector = shards_vector;
+
+  sort(expected_vector.begin(), expected_vector.end());
+
+  ASSERT_NO_THROW(Threaded_sort::quick_sort(shards_vector, parameters)); // exception
+
+  EXPECT_EQ(expected_vector, shards_vector);
+
+  // Mostly sorted time series with sparse disorder, and random vector (sorted by quick sort).
+  vector<int32_t> series_vector;
+  vector<int32_t> random_vector;
+
+  for (int32_t i = 0; i < 200000; i++)
+  {
+    series_vector.push_back((generator() % 50 == 0) ? static_cast<int32_t>(generator() % 200000) : i);
+    random_vector.push_back(static_cast<int32_t>(generator()));
+  }
+
+  for (vector<int32_t>* input_vector : { &series_vector, &random_vector })
+  {
+    expected_vector = *input_vector;
+
+    sort(expected_vector.begin(), expected_vector.end());
+
+    ASSERT_NO_THROW(Threaded_sort::quick_sort(*input_vector, parameters)); // exception
+
+    EXPECT_EQ(expected_vector, *input_vector);
+  }
+
+  // Move-only elements: descending runs are reversed and merged.
+  vector<Move_only_element> move_only_vector;
+
+  for (int32_t i = 0; i < 100000; i++)
+  {
+    const int32_t key = (i / 7000 % 2 == 0) ? (i % 7000) : -(i % 7000);
+
+    move_only_vector.push_back(Move_only_element{ std::unique_ptr<int32_t>(new int32_t(key)) });
+  }
+
+  ASSERT_NO_THROW(Threaded_sort::quick_sort(move_only_vector, parameters)); // exception
+
+  EXPECT_TRUE(is_sorted(move_only_vector.begin(), move_only_vector.end()));
+}
+
+TEST(ThreadedSortClassTest, MultiwayMerge)
+{
+  Sort_parameters parameters;
+  parameters.min_task_size = 1000;
+  parameters.sequential_sort_threshold = 0;
+
+  mt19937 generator(35);
+
+  // Dozens of sorted inputs of different sizes (some empty) with many equal keys.
+  vector<vector<Keyed_element>> inputs(40);
+  vector<Keyed_element> expected_vector;
+
+  for (int32_t input = 0; input < static_cast<int32_t>(inputs.size()); input++)
+  {
+    const int32_t input_size = (input % 7 == 3) ? 0 : static_cast<int32_t>(generator() % 5000);
+
+    for (int32_t i = 0; i < input_size; i++)
+    {
+      inputs[input].push_back(Keyed_element{ static_cast<int32_t>(generator() % 3000), input });
+    }
+
+    sort(inputs[input].begin(), inputs[input].end());
+
+    expected_vector.insert(expected_vector.end(), inputs[input].begin(), inputs[input].end());
+  }
+
+  stable_sort(expected_vector.begin(), expected_vector.end());
+
+  vector<Keyed_element> output;
+
+  ASSERT_NO_THROW(Threaded_sort::multiway_merge(inputs, output, parameters)); // exception
+
+  EXPECT_EQ(expected_vector, output);
+
+  // Iterator pairs: pieces of output are merged independently.
+  typedef vector<Keyed_element>::const_iterator Iterator;
+
+  vector<pair<Iterator, Iterator>> ranges;
+
+  for (const vector<Keyed_element>& input : inputs)
+  {
+    ranges.emplace_back(input.begin(), input.end());
+  }
+
+  const int64_t total_count = static_cast<int64_t>(expected_vector.size());
+
+  vector<Keyed_element> pieces_output(expected_vector.size());
+
+  for (int64_t piece = 0; piece < 13; piece++)
+  {
+    ASSERT_NO_THROW(Multiway_merge_async_task<Iterator>::merge(ranges, total_count * piece / 13,
+      total_count * (piece + 1) / 13, pieces_output)); // exception
+  }
+
+  EXPECT_EQ(expected_vector, pieces_output);
+
+  // Ranges of one array given by pointers.
+  vector<int32_t> keys = { 1, 4, 4, 9, 0, 2, 4, 3, 3, 3, 5 };
+
+  vector<pair<const int32_t*, const int32_t*>> pointer_ranges = { { &keys[0], &keys[4] }, { &keys[4], &keys[7] },
+    { &keys[7], &keys[7] }, { &keys[7], keys.data() + keys.size() } };
+
+  vector<int32_t> int_output;
+
+  ASSERT_NO_THROW(Threaded_sort::multiway_merge(pointer_ranges, int_output)); // exception
+
+  EXPECT_EQ(vector<int32_t>({ 0, 1, 2, 3, 3, 3, 4, 4, 4, 5, 9 }), int_output);
+
+  ASSERT_NO_THROW(Threaded_sort::multiway_merge(vector<vector<int32_t>>(), int_output)); // exception
+
+  EXPECT_TRUE(int_output.empty());
+}
+
+TEST(ThreadedSortClassTest, MergeBatch)
+{
+  Sort_parameters parameters;
+  parameters.min_task_size = 1000;
+  parameters.sequential_sort_threshold = 0;
+
+  mt19937 generator(36);
+
+  // Batches of different sizes are merged into growing vector: equal keys of vector precede keys of batch.
+  vector<Keyed_element> sorted_vector;
+
+  for (int32_t batch_size : { 0, 1, 5000, 20000, 300, 100000, 7 })
+  {
+    vector<Keyed_element> batch;
+
+    for (int32_t i = 0; i < batch_size; i++)
+    {
+      batch.push_back(Keyed_element{ static_cast<int32_t>(generator() % 2000), batch_size });
+    }
+
+    vector<Keyed_element> expected_vector = sorted_vector;
+
+    vector<Keyed_element> sorted_batch = batch;
+
+    stable_sort(sorted_batch.begin(), sorted_batch.end());
+
+    expected_vector.insert(expected_vector.end(), sorted_batch.begin(), sorted_batch.end());
+
+    inplace_merge(expected_vector.begin(), expected_vector.begin() + sorted_vector.size(), expected_vector.end());
+
+    ASSERT_NO_THROW(Threaded_sort::merge_batch(sorted_vector, batch, parameters)); // exception
+
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(expected_vector, sorted_vector);
+  }
+
+  EXPECT_THROW(Threaded_sort::merge_batch(sorted_vector, sorted_vector), invalid_argument); // exception
+
+  // Move-only elements are merged in place, elements without default constructor by std::inplace_merge.
+  vector<Move_only_element> move_only_vector;
+  vector<Move_only_element> move_only_batch;
+
+  vector<Counted_element> counted_vector;
+  vector<Counted_element> counted_batch;
+
+  for (int32_t i = 0; i < 50000; i++)
+  {
+    move_only_vector.push_back(Move_only_element{ std::unique_ptr<int32_t>(new int32_t(2 * i)) });
+    move_only_batch.push_back(Move_only_element{ std::unique_ptr<int32_t>(new int32_t(50000 - i)) });
+
+    counted_vector.emplace_back(i);
+    counted_batch.emplace_back(static_cast<int32_t>(generator() % 50000));
+  }
+
+  ASSERT_NO_THROW(Threaded_sort::merge_batch(move_only_vector, move_only_batch, parameters)); // exception
+
+  EXPECT_EQ(100000u, move_only_vector.size());
+  EXPECT_TRUE(is_sorted(move_only_vector.begin(), move_only_vector.end()));
+
+  Counted_element::s_copies_count = 0;
+
+  ASSERT_NO_THROW(Threaded_sort::merge_batch(counted_vector, counted_batch, parameters)); // exception
+
+  EXPECT_EQ(0, Counted_element::s_copies_count);
+  EXPECT_EQ(100000u, counted_vector.size());
+  EXPECT_TRUE(is_sorted(counted_vector.begin(), counted_vector.end()));
+}
+
+TEST(ThreadedSortClassTest, MergeBatchPieces)
+{
+  typedef vector<Keyed_element>::iterator Iterator;
+
+  mt19937 generator(36);
+
+  // Pieces are planned like merge_batch() does and merged in order: every piece overwrites the first elements of
+  // the next one before it is merged, so they are taken from saved elements.
+  for (int32_t pieces_count : { 2, 3, 7 })
+  {
+    for (int32_t size : { 0, 5, 1000 })
+    {
+      for (int32_t batch_size : { 1, 7, 3000 })
+      {
+        vector<Keyed_element> keyed_vector;
+        vector<Keyed_element> batch;
+
+        for (int32_t i = 0; i < size; i++)
+        {
+          keyed_vector.push_back(Keyed_element{ static_cast<int32_t>(generator() % 50), i });
+        }
+
+        for (int32_t i = 0; i < batch_size; i++)
+        {
+          batch.push_back(Keyed_element{ static_cast<int32_t>(generator() % 50), size + i });
+        }
+
+        stable_sort(keyed_vector.begin(), keyed_vector.end());
+        stable_sort(batch.begin(), batch.end());
+
+        // Equal elements of vector precede elements of batch.
+        vector<Keyed_element> expected_vector;
+
+        merge(keyed_vector.begin(), keyed_vector.end(), batch.begin(), batch.end(), back_inserter(expected_vector));
+
+        const int32_t total_size = size + batch_size;
+
+        keyed_vector.resize(total_size);
+
+        const vector<pair<Iterator, Iterator>> ranges = { { keyed_vector.begin(), keyed_vector.begin() + size },
+          { batch.begin(), batch.end() } };
+
+        vector<Batch_merge_piece> pieces(pieces_count);
+        vector<int64_t> counts;
+
+        int32_t saved_count = 0;
+
+        for (int32_t piece = 0; piece < pieces_count; piece++)
+        {
+          Multiway_merge_async_task<Iterator>::split(ranges,
+            static_cast<int64_t>(total_size) * (piece + 1) / pieces_count, counts); // exception
+
+          pieces[piece].first = (piece > 0) ? pieces[piece - 1].last : 0;
+          pieces[piece].batch_first = (piece > 0) ? pieces[piece - 1].batch_last : 0;
+          pieces[piece].last = static_cast<int32_t>(counts[0]);
+          pieces[piece].batch_last = static_cast<int32_t>(counts[1]);
+          pieces[piece].saved_first = saved_count;
+          pieces[piece].saved_count = min(pieces[piece].batch_first, pieces[piece].last - pieces[piece].first);
+
+          saved_count += pieces[piece].saved_count;
+        }
+
+        vector<Keyed_element> saved_elements;
+
+        for (const Batch_merge_piece& piece : pieces)
+        {
+          saved_elements.insert(saved_elements.end(), keyed_vector.begin() + piece.first,
+            keyed_vector.begin() + piece.first + piece.saved_count);
+        }
+
+        ASSERT_EQ(saved_count, static_cast<int32_t>(saved_elements.size()));
+
+        for (int32_t piece = 0; piece < pieces_count; piece++)
+        {
+          Batch_merge_async_task<Keyed_element>::merge(keyed_vector, batch, pieces[piece],
+            saved_elements.data()); // exception
+        }
+
+        EXPECT_EQ(expected_vector, keyed_vector);
+      }
+    }
+  }
+}
+
+TEST(ThreadedSortClassTest, SortReduceByKey)
+{
+  Sort_parameters parameters;
+  parameters.min_task_size = 1000;
+  parameters.sequential_sort_threshold = 0;
+
+  mt19937 generator(37);
+
+  // Values are summed per key: few groups, many groups and groups of one element.
+  for (int32_t keys_count : { 1, 10, 3000, 1000000 })
+  {
+    vector<Keyed_element> keyed_vector;
+    map<int32_t, int32_t> expected_sums;
+
+    for (int32_t i = 0; i < 100000; i++)
+    {
+      const Keyed_element element{ static_cast<int32_t>(generator() % keys_count), static_cast<int32_t>(i % 5) };
+
+      keyed_vector.push_back(element);
+
+      expected_sums[element.key] += element.input;
+    }
+
+    int32_t groups_count = 0;
+
+    ASSERT_NO_THROW(groups_count = Threaded_sort::sort_reduce_by_key(keyed_vector,
+      [](Keyed_element& result, const Keyed_element& element) { result.input += element.input; },
+      parameters)); // exception
+
+    ASSERT_EQ(static_cast<int32_t>(expected_sums.size()), groups_count);
+
+    vector<Keyed_element> expected_vector;
+
+    for (const pair<const int32_t, int32_t>& sum : expected_sums)
+    {
+      expected_vector.push_back(Keyed_element{ sum.first, sum.second });
+    }
+
+    EXPECT_TRUE(equal(expected_vector.begin(), expected_vector.end(), keyed_vector.begin()));
+  }
+
+  // Unique elements, default parameters, move-only elements and empty vector.
+  vector<int32_t> int_vector;
+
+  for (int32_t i = 0; i < 200000; i++)
+  {
+    int_vector.push_back(static_cast<int32_t>(generator() % 50000));
+  }
+
+  vector<int32_t> expected_vector = int_vector;
+
+  sort(expected_vector.begin(), expected_vector.end());
+
+  expected_vector.erase(unique(expected_vector.begin(), expected_vector.end()), expected_vector.end());
+
+  int32_t unique_count = 0;
+
+  ASSERT_NO_THROW(unique_count = Threaded_sort::sort_unique(int_vector)); // exception
+
+  int_vector.resize(unique_count);
+
+  EXPECT_EQ(expected_vector, int_vector);
+
+  vector<Move_only_element> move_only_vector;
+
+  for (int32_t i = 0; i < 100000; i++)
+  {
+    move_only_vector.push_back(Move_only_element{ std::unique_ptr<int32_t>(new int32_t(i % 777)) });
+  }
+
+  ASSERT_NO_THROW(unique_count = Threaded_sort::sort_unique(move_only_vector, parameters)); // exception
+
+  ASSERT_EQ(777, unique_count);
+
+  for (int32_t i = 0; i < unique_count; i++)
+  {
+    EXPECT_EQ(i, *move_only_vector[i].key);
+  }
+
+  int_vector.clear();
+
+  ASSERT_NO_THROW(unique_count = Threaded_sort::sort_unique(int_vector)); // exception
+
+  EXPECT_EQ(0, unique_count);
+}
+
+TEST(ThreadedSortClassTest, ReduceChunks)
+{
+  mt19937 generator(37);
+
+  auto add_input = [](Keyed_element& result, const Keyed_element& element) { result.input += element.input; };
+
+  typedef Reduce_async_task<Keyed_element, decltype(add_input)> Task;
+
+  // Chunks are processed stage by stage like sort_reduce_by_key() does (chunks of stage are independent).
+  for (int32_t chunks_count : { 2, 3, 7 })
+  {
+    for (int32_t keys_count : { 1, 4, 300, 100000 })
+    {
+      vector<Keyed_element> keyed_vector;
+      map<int32_t, int32_t> expected_sums;
+
+      for (int32_t i = 0; i < 3000; i++)
+      {
+        const Keyed_element element{ static_cast<int32_t>(generator() % keys_count), static_cast<int32_t>(i % 5) };
+
+        keyed_vector.push_back(element);
+
+        expected_sums[element.key] += element.input;
+      }
+
+      sort(keyed_vector.begin(), keyed_vector.end());
+
+      vector<Reduce_chunk> chunks;
+
+      Reduce_chunk::split(keyed_vector, chunks_count, chunks); // exception
+
+      ASSERT_EQ(chunks_count, static_cast<int32_t>(chunks.size()));
+      ASSERT_EQ(0, chunks.front().first);
+      ASSERT_EQ(3000, chunks.back().last);
+
+      // Chunks are adjacent, groups are not split.
+      for (int32_t chunk = 1; chunk < chunks_count; chunk++)
+      {
+        const int32_t boundary = chunks[chunk].first;
+
+        ASSERT_EQ(chunks[chunk - 1].last, boundary);
+
+        if (boundary > 0 && boundary < 3000)
+        {
+          EXPECT_LT(keyed_vector[boundary - 1].key, keyed_vector[boundary].key);
+        }
+      }
+
+      for (int32_t chunk = chunks_count - 1; chunk >= 0; chunk--)
+      {
+        Task::execute_stage(keyed_vector, chunks[chunk], add_input, nullptr, Reduce_chunk::Stage::reduce);
+      }
+
+      int32_t moved_count = 0;
+
+      const int32_t results_count = Reduce_chunk::set_outputs(chunks, moved_count);
+
+      ASSERT_EQ(static_cast<int32_t>(expected_sums.size()), results_count);
+
+      allocator<Keyed_element> element_allocator;
+
+      Keyed_element* saved_elements = (moved_count > 0) ? element_allocator.allocate(moved_count) : nullptr;
+
+      for (int32_t chunk = chunks_count - 1; chunk >= 0; chunk--)
+      {
+        Task::execute_stage(keyed_vector, chunks[chunk], add_input, saved_elements, Reduce_chunk::Stage::save);
+      }
+
+      for (int32_t chunk = chunks_count - 1; chunk >= 0; chunk--)
+      {
+        Task::execute_stage(keyed_vector, chunks[chunk], add_input, saved_elements, Reduce_chunk::Stage::restore);
+      }
+
+      if (saved_elements != nullptr)
+      {
+        element_allocator.deallocate(saved_elements, moved_count);
+      }
+
+      vector<Keyed_element> expected_vector;
+
+      for (const pair<const int32_t, int32_t>& sum : expected_sums)
+      {
+        expected_vector.push_back(Keyed_element{ sum.first, sum.second });
+      }
+
+      EXPECT_TRUE(equal(expected_vector.begin(), expected_vector.end(), keyed_vector.begin()));
+    }
+  }
+}
+
+TEST(ThreadedSortClassTest, SortWorkspace)
+{
+  Sort_parameters parameters;
+  parameters.min_task_size = 1000;
+  parameters.sequential_sort_threshold = 0;
+  parameters.indirect_sort_element_size = 128;
+
+  EXPECT_THROW(Sort_workspace(0, 48), invalid_argument); // exception
+
+  // Merge buffer of adaptive sort (half of vector) is counted for any element type.
+  Sort_parameters not_adaptive_parameters = parameters;
+  not_adaptive_parameters.adaptive_run_length = 0;
+
+  EXPECT_LE(50000 * sizeof(int32_t), Threaded_sort::get_workspace_size<int32_t>(100000, parameters));
+  EXPECT_EQ(0u, Threaded_sort::get_workspace_size<int32_t>(100000, not_adaptive_parameters));
+  EXPECT_LT(0u, Threaded_sort::get_workspace_size<Large_record>(100000, not_adaptive_parameters));
+  EXPECT_LT(0u, Threaded_sort::get_workspace_size<string>(100000, not_adaptive_parameters));
+
+  // Buffers are allocated from workspace while it has free memory, then from heap.
+  {
+    Sort_workspace workspace(1024);
+
+    EXPECT_EQ(1, workspace.get_blocks_count());
+
+    Sort_workspace::Scope scope(&workspace);
+
+    Workspace_vector<int32_t> small_vector(100, Workspace_allocator<int32_t>(&workspace));
+    Workspace_vector<int32_t> large_vector(1000, Workspace_allocator<int32_t>(&workspace));
+
+    EXPECT_TRUE(workspace.is_owner(small_vector.data()));
+    EXPECT_FALSE(workspace.is_owner(large_vector.data()));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(small_vector.data()) % Sort_workspace::s_default_alignment);
+  }
+
+  // Merge buffer of adaptive sort is taken from heap without workspace: sorted shards are merged.
+  mt19937 generator(38);
+
+  vector<int32_t> shards_vector(100000);
+
+  auto fill_shards = [&generator, &shards_vector]()
+  {
+    for (int32_t& element : shards_vector)
+    {
+      element = static_cast<int32_t>(generator() % 1000000);
+    }
+
+    for (int32_t shard = 0; shard < 4; shard++)
+    {
+      sort(shards_vector.begin() + shard * 25000, shards_vector.begin() + (shard + 1) * 25000);
+    }
+  };
+
+  fill_shards();
+
+  const int32_t heap_allocations_count = Allocation_counter::count_large_allocations([&]()
+  {
+    EXPECT_NO_THROW(Threaded_sort::quick_sort(shards_vector, parameters)); // exception
+  });
+
+  EXPECT_LT(0, heap_allocations_count);
+
+  EXPECT_TRUE(is_sorted(shards_vector.begin(), shards_vector.end()));
+
+  // Workspace is sized once and reused by all sorts (also with huge pages if they are available): scratch buffers
+  // are not allocated from heap.
+  const size_t workspace_size = max({ Threaded_sort::get_workspace_size<Large_record>(100000, parameters),
+    Threaded_sort::get_workspace_size<string>(100000, parameters),
+    Threaded_sort::get_workspace_size<int32_t>(100000, parameters), 100000 * sizeof(int32_t) });
+
+  // Several chunks: elements saved by merge of batch and results saved by reduction are taken from workspace.
+  Threaded_sort::set_workers_count(4);
+
+  for (bool is_huge_pages_used : { false, true })
+  {
+    Sort_workspace workspace(workspace_size, Sort_workspace::s_default_alignment, is_huge_pages_used);
+
+    vector<Large_record> record_vector(100000);
+    vector<string> string_vector(100000);
+    vector<int32_t> unique_vector(100000);
+    vector<int32_t> batch(20000);
+
+    for (int32_t iteration = 0; iteration < 3; iteration++)
+    {
+      for (Large_record& record : record_vector)
+      {
+        record.key = static_cast<int64_t>(generator() % 50000);
+      }
+
+      for (string& text : string_vector)
+      {
+        text = "key_" + to_string(generator() % 50000);
+      }
+
+      for (int32_t& element : unique_vector)
+      {
+        element = static_cast<int32_t>(generator() % 50000);
+      }
+
+      for (int32_t& element : batch)
+      {
+        element = static_cast<int32_t>(generator() % 1000000);
+      }
+
+      fill_shards();
+
+      vector<int32_t> expected_vector = shards_vector;
+
+      expected_vector.insert(expected_vector.end(), batch.begin(), batch.end());
+
+      sort(expected_vector.begin(), expected_vector.end());
+
+      int32_t unique_count = 0;
+
+      // Vector has capacity for batch: only scratch buffers could be allocated.
+      shards_vector.reserve(shards_vector.size() + batch.size());
+
+      const int32_t allocations_count = Allocation_counter::count_large_allocations([&]()
+      {
+        EXPECT_NO_THROW(Threaded_sort::quick_sort(record_vector, parameters, workspace)); // exception
+        EXPECT_NO_THROW(Threaded_sort::string_sort(string_vector, parameters, workspace)); // exception
+        EXPECT_NO_THROW(Threaded_sort::quick_sort(shards_vector, parameters, nullptr, workspace)); // exception
+        EXPECT_NO_THROW(Threaded_sort::merge_batch(shards_vector, batch, parameters, workspace)); // exception
+        EXPECT_NO_THROW(unique_count = Threaded_sort::sort_unique(unique_vector, parameters, workspace)); // exception
+      });
+
+      EXPECT_EQ(0, allocations_count);
+
+      EXPECT_TRUE(is_sorted(record_vector.begin(), record_vector.end()));
+      EXPECT_TRUE(is_sorted(string_vector.begin(), string_vector.end()));
+      EXPECT_EQ(expected_vector, shards_vector);
+      EXPECT_TRUE(is_sorted(unique_vector.begin(), unique_vector.begin() + unique_count));
+      EXPECT_TRUE(adjacent_find(unique_vector.begin(), unique_vector.begin() + unique_count) ==
+        unique_vector.begin() + unique_count);
+
+      EXPECT_EQ(1, workspace.get_blocks_count());
+      EXPECT_EQ(0u, workspace.get_used_size());
+
+      shards_vector.resize(100000);
+      batch.resize(20000);
+    }
+  }
+
+  // Sort by cached keys: key entries, order of elements and buffers of permutation are taken from workspace which
+  // is grown by the first sort.
+  {
+    Sort_workspace workspace;
+
+    vector<Keyed_element> keyed_vector(100000);
+
+    auto fill_keys = [&generator, &keyed_vector]()
+    {
+      for (int32_t i = 0; i < static_cast<int32_t>(keyed_vector.size()); i++)
+      {
+        keyed_vector[i] = Keyed_element{ static_cast<int32_t>(generator() % 1000), i };
+      }
+    };
+
+    fill_keys();
+
+    EXPECT_LT(0, Allocation_counter::count_large_allocations([&]()
+    {
+      EXPECT_NO_THROW(Threaded_sort::sort_by_key(keyed_vector, &Keyed_element::key, parameters)); // exception
+    }));
+
+    fill_keys();
+
+    ASSERT_NO_THROW(Threaded_sort::sort_by_key(keyed_vector, &Keyed_element::key, parameters,
+      workspace)); // exception
+
+    for (int32_t iteration = 0; iteration < 3; iteration++)
+    {
+      fill_keys();
+
+      vector<Keyed_element> expected_vector = keyed_vector;
+
+      stable_sort(expected_vector.begin(), expected_vector.end(),
+        [](const Keyed_element& left, const Keyed_element& right) { return (left.key > right.key); });
+
+      const int32_t allocations_count = Allocation_counter::count_large_allocations([&]()
+      {
+        EXPECT_NO_THROW(Threaded_sort::sort_by_key(keyed_vector, &Keyed_element::key, greater<>(), parameters,
+          workspace)); // exception
+      });
+
+      EXPECT_EQ(0, allocations_count);
+
+      EXPECT_EQ(expected_vector, keyed_vector);
+
+      EXPECT_EQ(1, workspace.get_blocks_count());
+      EXPECT_EQ(0u, workspace.get_used_size());
+    }
+  }
+
+  Threaded_sort::set_workers_count(0);
+}
+
+TEST(ThreadedSortClassTest, SortWorkspaceAlignment)
+{
+  // Alignment of workspace between page and huge page and over-aligned elements.
+  for (size_t alignment : { Sort_workspace::s_default_alignment, static_cast<size_t>(64 * 1024) })
+  {
+    for (bool is_huge_pages_used : { false, true })
+    {
+      for (int32_t iteration = 0; iteration < 8; iteration++)
+      {
+        Sort_workspace workspace(1024 * 1024, alignment, is_huge_pages_used);
+
+        Sort_workspace::Scope scope(&workspace);
+
+        const uintptr_t buffer = reinterpret_cast<uintptr_t>(workspace.allocate(1, 1));
+
+        EXPECT_EQ(0u, buffer % alignment);
+
+        Over_aligned_element* elements = Workspace_allocator<Over_aligned_element>(&workspace).allocate(16);
+
+        EXPECT_TRUE(workspace.is_owner(elements));
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(elements) % alignof(Over_aligned_element));
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(elements) % alignment);
+      }
+    }
+  }
+}
+
+TEST(ThreadedSortClassTest, SortByKey)
+{
+  Sort_parameters parameters;
+  parameters.min_task_size = 1000;
+  parameters.sequential_sort_threshold = 0;
+
+  mt19937 generator(39);
+
+  // Key of every element is computed once, equal keys keep order: large and small vectors.
+  for (int32_t size : { 100000, 100 })
+  {
+    vector<Keyed_element> keyed_vector;
+
+    for (int32_t i = 0; i < size; i++)
+    {
+      keyed_vector.push_back(Keyed_element{ static_cast<int32_t>(generator() % 1000), i });
+    }
+
+    // Keys are negated: expected order is descending.
+    vector<Keyed_element> expected_vector = keyed_vector;
+
+    stable_sort(expected_vector.begin(), expected_vector.end(),
+      [](const Keyed_element& left, const Keyed_element& right) { return (left.key > right.key); });
+
+    std::atomic<int32_t> keys_count(0);
+
+    ASSERT_NO_THROW(Threaded_sort::sort_by_key(keyed_vector,
+      [&keys_count](const Keyed_element& element) { keys_count++; return -element.key; }, parameters)); // exception
+
+    EXPECT_EQ(size, keys_count.load());
+
+    EXPECT_EQ(expected_vector, keyed_vector);
+
+    // Pointer to member is projection, default parameters.
+    ASSERT_NO_THROW(Threaded_sort::sort_by_key(keyed_vector, &Keyed_element::key)); // exception
+
+    stable_sort(expected_vector.begin(), expected_vector.end());
+
+    EXPECT_EQ(expected_vector, keyed_vector);
+
+    // Comparison of keys gives descending order, equal keys keep order.
+    stable_sort(expected_vector.begin(), expected_vector.end(),
+      [](const Keyed_element& left, const Keyed_element& right) { return (left.key > right.key); });
+
+    ASSERT_NO_THROW(Threaded_sort::sort_by_key(keyed_vector, &Keyed_element::key, greater<>(),
+      parameters)); // exception
+
+    EXPECT_EQ(expected_vector, keyed_vector);
+
+    // Stateful comparison, default parameters: ascending order of keys modulo 10.
+    const int32_t modulo = 10;
+
+    stable_sort(expected_vector.begin(), expected_vector.end(),
+      [modulo](const Keyed_element& left, const Keyed_element& right)
+      {
+        return (left.key % modulo < right.key % modulo);
+      });
+
+    ASSERT_NO_THROW(Threaded_sort::sort_by_key(keyed_vector, &Keyed_element::key,
+      [modulo](int32_t left, int32_t right) { return (left % modulo < right % modulo); })); // exception
+
+    EXPECT_EQ(expected_vector, keyed_vector);
+  }
+
+  // Strings are sorted by parsed numbers.
+  vector<string> string_vector;
+
+  for (int32_t i = 0; i < 50000; i++)
+  {
+    string_vector.push_back(to_string(generator() % 1000000));
+  }
+
+  ASSERT_NO_THROW(Threaded_sort::sort_by_key(string_vector,
+    [](const string& element) { return stoll(element); }, parameters)); // exception
+
+  EXPECT_TRUE(is_sorted(string_vector.begin(), string_vector.end(),
+    [](const string& left, const string& right) { return (stoll(left) < stoll(right)); }));
+
+  // Error of projection is thrown, vector is not changed.
+  string_vector.push_back("x");
+
+  const vector<string> input_vector = string_vector;
+
+  EXPECT_THROW(Threaded_sort::sort_by_key(string_vector,
+    [](const string& element) { return stoll(element); }, parameters), exception); // exception
+
+  EXPECT_EQ(input_vector, string_vector);
+}
+
+TEST(ThreadedSortClassTest, ShardedSort)
+{
+  Sort_parameters parameters;
+  parameters.min_task_size = 1000;
+  parameters.sequential_sort_threshold = 0;
+
+  mt19937 generator(40);
+
+  // Several workers: elements are scattered by chunks in parallel.
+  Threaded_sort::set_workers_count(4);
+
+  // Random keys, few unique keys and sorted keys are sorted by several processes.
+  for (int32_t keys_count : { 1000000000, 3, 0 })
+  {
+    vector<int64_t> int_vector;
+
+    for (int32_t i = 0; i < 200000; i++)
+    {
+      int_vector.push_back((keys_count > 0) ? static_cast<int64_t>(generator() % keys_count) : i);
+    }
+
+    vector<int64_t> expected_vector = int_vector;
+
+    sort(expected_vector.begin(), expected_vector.end());
+
+    ASSERT_NO_THROW(Threaded_sort::sharded_sort(int_vector, 4, parameters)); // exception
+
+    EXPECT_EQ(expected_vector, int_vector);
+  }
+
+  // Trivially copyable records, default parameters.
+  vector<Keyed_element> keyed_vector;
+
+  for (int32_t i = 0; i < 100000; i++)
+  {
+    keyed_vector.push_back(Keyed_element{ static_cast<int32_t>(generator() % 10000), i });
+  }
+
+  vector<Keyed_element> expected_vector = keyed_vector;
+
+  ASSERT_NO_THROW(Threaded_sort::sharded_sort(keyed_vector, 3)); // exception
+
+  sort(expected_vector.begin(), expected_vector.end());
+
+  for (size_t i = 0; i < expected_vector.size(); i++)
+  {
+    ASSERT_EQ(expected_vector[i].key, keyed_vector[i].key);
+  }
+
+  // Small vector is sorted by calling process.
+  vector<int32_t> small_vector = { 5, 3, 1, 4, 2 };
+
+  ASSERT_NO_THROW(Threaded_sort::sharded_sort(small_vector, 2)); // exception
+
+  EXPECT_EQ(vector<int32_t>({ 1, 2, 3, 4, 5 }), small_vector);
+
+  EXPECT_THROW(Threaded_sort::sharded_sort(small_vector, 0), invalid_argument);
+
+#ifdef __linux__
+  // Comparison fails only in worker processes: error is reported and vector is not changed.
+  vector<Parent_only_element> parent_only_vector;
+
+  for (int32_t i = 0; i < 200000; i++)
+  {
+    parent_only_vector.push_back(Parent_only_element{ static_cast<int64_t>(generator() % 1000000) });
+  }
+
+  const vector<Parent_only_element> input_vector = parent_only_vector;
+
+  EXPECT_THROW(Threaded_sort::sharded_sort(parent_only_vector, 4, parameters), runtime_error);
+
+  for (size_t i = 0; i < input_vector.size(); i++)
+  {
+    ASSERT_EQ(input_vector[i].key, parent_only_vector[i].key);
+  }
+#endif // __linux__
+
+  Threaded_sort::set_workers_count(0);
+
+  // Shared memory region.
+  Shared_memory_region region(4096);
+
+  EXPECT_EQ(4096u, region.get_size());
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(region.get_data()) % 4096);
+
+  EXPECT_THROW(Shared_memory_region(0), invalid_argument);
+}
+
+TEST(ThreadedSortClassTest, WorkersCount)
+{
+  EXPECT_THROW(Threaded_sort::set_workers_count(-1), invalid_argument);
+
+  EXPECT_EQ(max<int32_t>(static_cast<int32_t>(thread::hardware_concurrency()), 1), Threaded_sort::get_workers_count());
+
+  // Work is split into chunks for 7 workers independently of count of CPUs.
+  Threaded_sort::set_workers_count(7);
+
+  EXPECT_EQ(7, Threaded_sort::get_workers_count());
+
+  Sort_parameters parameters;
+  parameters.min_task_size = 1000;
+  parameters.sequential_sort_threshold = 0;
+  parameters.indirect_sort_element_size = 128;
+
+  mt19937 generator(39);
+
+  auto generate = [&generator](int32_t size, int32_t keys_count)
+  {
+    vector<Keyed_element> keyed_vector;
+
+    for (int32_t i = 0; i < size; i++)
+    {
+      keyed_vector.push_back(Keyed_element{ static_cast<int32_t>(generator() % keys_count), i });
+    }
+
+    return keyed_vector;
+  };
+
+  // Multiway merge and merge of batch are stable.
+  vector<Keyed_element> first_input = generate(60000, 1000);
+  vector<Keyed_element> second_input = generate(40000, 1000);
+
+  stable_sort(first_input.begin(), first_input.end());
+  stable_sort(second_input.begin(), second_input.end());
+
+  vector<Keyed_element> expected_vector;
+
+  merge(first_input.begin(), first_input.end(), second_input.begin(), second_input.end(),
+    back_inserter(expected_vector));
+
+  vector<Keyed_element> merged_vector;
+
+  EXPECT_NO_THROW(Threaded_sort::multiway_merge(vector<vector<Keyed_element>>({ first_input, second_input }),
+    merged_vector, parameters)); // exception
+
+  EXPECT_EQ(expected_vector, merged_vector);
+
+  EXPECT_NO_THROW(Threaded_sort::merge_batch(first_input, second_input, parameters)); // exception
+
+  EXPECT_EQ(expected_vector, first_input);
+
+  // Keys are extracted by chunks, equal keys keep order.
+  vector<Keyed_element> keyed_vector = generate(100000, 1000);
+
+  expected_vector = keyed_vector;
+
+  stable_sort(expected_vector.begin(), expected_vector.end());
+
+  EXPECT_NO_THROW(Threaded_sort::sort_by_key(keyed_vector, &Keyed_element::key, parameters)); // exception
+
+  EXPECT_EQ(expected_vector, keyed_vector);
+
+  // Sorted shards are scanned by chunks and merged.
+  keyed_vector = generate(100000, 1000000);
+
+  for (int32_t shard = 0; shard < 5; shard++)
+  {
+    sort(keyed_vector.begin() + shard * 20000, keyed_vector.begin() + (shard + 1) * 20000);
+  }
+
+  EXPECT_NO_THROW(Threaded_sort::quick_sort(keyed_vector, parameters)); // exception
+
+  EXPECT_TRUE(is_sorted(keyed_vector.begin(), keyed_vector.end()));
+
+  // Groups are reduced and compacted by chunks.
+  keyed_vector = generate(100000, 5000);
+
+  map<int32_t, int32_t> expected_sums;
+
+  for (const Keyed_element& element : keyed_vector)
+  {
+    expected_sums[element.key] += element.input;
+  }
+
+  int32_t groups_count = 0;
+
+  EXPECT_NO_THROW(groups_count = Threaded_sort::sort_reduce_by_key(keyed_vector,
+    [](Keyed_element& result, const Keyed_element& element) { result.input += element.input; },
+    parameters)); // exception
+
+  EXPECT_EQ(static_cast<int32_t>(expected_sums.size()), groups_count);
+
+  for (int32_t group = 0; group < groups_count && group < static_cast<int32_t>(keyed_vector.size()); group++)
+  {
+    EXPECT_EQ(expected_sums[keyed_vector[group].key], keyed_vector[group].input);
+  }
+
+  // Large records are permuted by chunks.
+  vector<Large_record> record_vector(100000);
+
+  for (Large_record& record : record_vector)
+  {
+    record.key = static_cast<int64_t>(generator() % 50000);
+  }
+
+  EXPECT_NO_THROW(Threaded_sort::quick_sort(record_vector, parameters)); // exception
+
+  EXPECT_TRUE(is_sorted(record_vector.begin(), record_vector.end()));
+
+  Threaded_sort::set_workers_count(0);
+
+  EXPECT_EQ(max<int32_t>(static_cast<int32_t>(thread::hardware_concurrency()), 1), Threaded_sort::get_workers_count());
+}
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file pch.h
+/// @brief Precompiled Header File.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PCH_H_A43F1D7B_9C26_4E85_B1D0_6E2C58F7A3B9
+#define PCH_H_A43F1D7B_9C26_4E85_B1D0_6E2C58F7A3B9
+
+#include <stdint.h>
+#include <cstddef>
+#include <cassert>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <array>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include <functional>
+#include <list>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <map>
+#include <system_error>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <chrono>
+#include <typeinfo>
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "threaded_sort/async_task.h"
+#include "threaded_sort/async_tasks_manager.h"
+#include "threaded_sort/sort_parameters.h"
+#include "threaded_sort/tuning_profile.h"
+#include "threaded_sort/thread_placement.h"
+#include "threaded_sort/shared_memory_region.h"
+#include "threaded_sort/sort_workspace.h"
+#include "threaded_sort/sorting_network.h"
+#include "threaded_sort/sort_async_task.h"
+#include "threaded_sort/segments_sort_async_task.h"
+#include "threaded_sort/element_pointer.h"
+#include "threaded_sort/permute_async_task.h"
+#include "threaded_sort/string_entry.h"
+#include "threaded_sort/string_sort_async_task.h"
+#include "threaded_sort/natural_run.h"
+#include "threaded_sort/run_scan_async_task.h"
+#include "threaded_sort/run_merge_async_task.h"
+#include "threaded_sort/multiway_merge_async_task.h"
+#include "threaded_sort/batch_merge_async_task.h"
+#include "threaded_sort/reduce_async_task.h"
+#include "threaded_sort/shard_scatter_async_task.h"
+#include "threaded_sort/key_entry.h"
+#include "threaded_sort/key_extract_async_task.h"
+#include "threaded_sort/threaded_sort.h"
+#include "threaded_sort/sort_tuner.h"
+
+#endif // PCH_H_A43F1D7B_9C26_4E85_B1D0_6E2C58F7A3B9
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file threaded_sort_tuner.cpp
+/// @brief Calibrates Threaded_sort parameters on current machine and saves tuning profile.
+/// @author Sergey Stepanenko (sergey.stepanenko.27@gmail.com)
+///
+/// Usage: threaded_sort_tuner [profile path] [sample size]
+/// Default profile path is threaded_sort.profile, default sample size is Sort_tuner::s_default_sample_size.
+/// To use profile set environment variable THREADED_SORT_TUNING_PROFILE=<profile path> for sorting processes.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pch.h"
+
+using namespace std;
+
+using namespace My_cpp_libs;
+
+namespace
+{
+
+/// @brief Generates sample of uniformly distributed random values.
+template <class T>
+void generate_sample(size_t size, vector<T>& sample)
+{
+  mt19937_64 generator(size);
+  uniform_int_distribution<int64_t> uniform(0, numeric_limits<int32_t>::max());
+
+  sample.clear();
+
+  sample.reserve(size); // exception
+
+  for (size_t i = 0; i < size; i++)
+  {
+    sample.push_back(static_cast<T>(uniform(generator))); // exception
+  }
+}
+
+/// @brief Generates sample of random strings (longer than small string buffer).
+void generate_sample(size_t size, vector<string>& sample)
+{
+  vector<int64_t> keys;
+
+  generate_sample(size, keys); // exception
+
+  sample.clear();
+
+  sample.reserve(size); // exception
+
+  for (int64_t key : keys)
+  {
+    char buffer[32];
+
+    snprintf(buffer, sizeof(buffer), "key/%020lld", static_cast<long long>(key));
+
+    sample.push_back(buffer); // exception
+  }
+}
+
+/// @brief Calibrates parameters for element type and prints them.
+template <class T>
+void calibrate(const char* type_name, size_t sample_size, Tuning_profile& profile)
+{
+  vector<T> sample;
+
+  generate_sample(sample_size, sample); // exception
+
+  Sort_tuner::calibrate(sample, profile); // exception
+
+  Sort_parameters parameters = profile.get_parameters(typeid(T).name(), static_cast<int32_t>(sizeof(T)));
+
+  printf("%-8s max_recursion_depth=%d min_task_size=%d insertion_sort_threshold=%d sequential_sort_threshold=%d\n",
+    type_name, parameters.max_recursion_depth, parameters.min_task_size, parameters.insertion_sort_threshold,
+    parameters.sequential_sort_threshold);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const string profile_path = (argc > 1) ? argv[1] : "threaded_sort.profile";
+
+  try
+  {
+    const long long sample_size = (argc > 2) ? stoll(argv[2]) : Sort_tuner::s_default_sample_size; // exception
+
+    if (sample_size < 2 || sample_size > numeric_limits<int32_t>::max())
+    {
+      throw invalid_argument("sample size");
+    }
+
+    Tuning_profile profile;
+
+    calibrate<int32_t>("int32", static_cast<size_t>(sample_size), profile); // exception
+    calibrate<int64_t>("int64", static_cast<size_t>(sample_size), profile); // exception
+    calibrate<double>("double", static_cast<size_t>(sample_size), profile); // exception
+    calibrate<string>("string", static_cast<size_t>(sample_size), profile); // exception
+
+    profile.save(profile_path); // exception
+  }
+  catch (exception& error)
+  {
+    fprintf(stderr, "Calibration failed: %s\n", error.what());
+
+    return 1;
+  }
+
+  printf("Tuning profile is saved to %s\n", profile_path.c_str());
+
+  return 0;
+}